@@ -0,0 +1,50 @@
+#include "ApplicationDelta.h"
+#include "common/Application.h"
+#include "common/Configuration.h"
+#include "services/configuration/ConfigurationDelta.h"
+#include <QDebug>
+
+using namespace Applications;
+
+ApplicationDelta ApplicationDelta::apply(const Services::Configuration::ConfigurationDelta& delta, Common::DynamicApplicationMap& applications, const Factory& create)
+{
+    ApplicationDelta applied;
+
+    for (const QString& id : delta.removedApplications) {
+        Common::Application* app = applications.take(id);
+        if (app) {
+            qDebug() << "Destroying application:" << id;
+            delete app;
+            ++applied.destroyed;
+        }
+    }
+
+    for (const QJsonObject& appConfig : delta.addedApplications) {
+        Common::Application* app = create(appConfig);
+        if (app) {
+            applications[app->id()] = app;
+            ++applied.created;
+        }
+    }
+
+    // The rotation plan and the retained backgrounds only change with these fields
+    applied.rotationChanged = applied.destroyed > 0 || applied.created > 0;
+    applied.backgroundsChanged = applied.rotationChanged;
+    for (const QJsonObject& changes : delta.changedApplications) {
+        Common::Application* app = applications.value(changes["id"].toString(), nullptr);
+        if (!app) {
+            qWarning() << "Cannot apply changes to unknown application:" << changes["id"].toString();
+            continue;
+        }
+
+        app->applyConfiguration(changes);
+        applied.rotationChanged |= changes.contains("enabled");
+        for (const QString& key : Common::Configuration::scheduleKeys()) {
+            applied.rotationChanged |= changes.contains(key);
+        }
+        applied.backgroundsChanged |= changes.contains("enabled") || changes.contains("background");
+        ++applied.updated;
+    }
+
+    return applied;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QJsonObject>
+#include <functional>
+
+#include "common/Types.h"
+
+namespace Services::Configuration
+{
+struct ConfigurationDelta;
+}
+
+namespace Applications
+{
+/**
+ * Outcome of applying a configuration delta to the dynamic applications. Removed applications
+ * are destroyed and added ones created; every other application keeps its object and is only
+ * handed the fields that changed, so only the NOTIFY signals of those fields fire.
+ */
+struct ApplicationDelta
+{
+    // Creates a configured application, null when the configuration does not describe a valid one
+    using Factory = std::function<Common::Application*(const QJsonObject& appConfig)>;
+
+    static ApplicationDelta apply(const Services::Configuration::ConfigurationDelta& delta, Common::DynamicApplicationMap& applications, const Factory& create);
+
+    int created = 0;
+    int destroyed = 0;
+    int updated = 0;
+    bool rotationChanged = false;    // The rotation plan has to be rebuilt
+    bool backgroundsChanged = false; // The retained backgrounds have to be updated
+};
+} // namespace Applications
@@ -1,12 +1,17 @@
 #include "Container.h"
+#include "ApplicationDelta.h"
+#include "applications/common/Configuration.h"
 #include "services/Container.h"
+#include "services/configuration/ConfigurationDelta.h"
 #include "services/configuration/DeviceConfiguration.h"
 #include <QDebug>
+#include <algorithm>
 
 using namespace Applications;
 
 Container::Container(Services::Container& services, QObject* parent)
     : QObject(parent),
+      m_dateTime(*services.m_dateTime),
       m_applications(),
       m_setup(new Setup::Application(m_applications, *services.m_configuration, this)),
       m_debug(new Debug::Application(this)),
@@ -17,10 +22,15 @@ Container::Container(Services::Container& services, QObject* parent)
         qInfo() << "Configuration changed, reloading applications";
         reload(*services.m_configuration, *services.m_media);
     });
+    connect(services.m_configuration, &Services::Configuration::Service::configurationUpdated, this, [this, &services](const Services::Configuration::ConfigurationDelta& delta) {
+        qInfo() << "Configuration updated, applying changes to applications";
+        update(delta, *services.m_configuration, *services.m_media);
+    });
 
-    // When startup check is already completed, reload immediately to apply initial configuration (if any present).
-    if (!services.m_configuration->startupCheckInProgress() &&
-        !services.m_media->startupCheckInProgress()) {
+    // When startup check is already completed, or skipped because a cached configuration was loaded,
+    // reload immediately to apply initial configuration (if any present). Backgrounds that are still
+    // being synchronized are picked up when the media sync completes.
+    if (!services.m_configuration->startupCheckInProgress()) {
         reload(*services.m_configuration, *services.m_media);
     }
 
@@ -33,6 +43,11 @@ bool Container::reloading() const
     return m_reloading;
 }
 
+Watchface::Application* Container::watchface() const
+{
+    return m_watchface;
+}
+
 void Container::setReloading(bool reloading)
 {
     if (m_reloading != reloading) {
@@ -63,56 +78,131 @@ void Container::reload(Services::Configuration::Service& configuration, Services
 
     // Destroy existing dynamic applications
     qInfo() << "Destroying existing applications before reloading from configuration";
-    for (auto it = m_applications.begin(); it != m_applications.end(); ++it) {
-        if (it.value()) {
-            qDebug() << "Destroying application:" << it.key();
-            delete it.value();
-        }
+    const QStringList ids = m_applications.keys();
+    for (const QString& id : ids) {
+        destroyApplication(id);
     }
-    m_applications.clear();
 
     qInfo() << "Creating" << config->applicationCount() << "applications from configuration";
     for (const QJsonObject& appConfig : config->applications) {
-        QString id = appConfig["id"].toString();
-        Common::Type type = Common::typeFromString(appConfig["type"].toString());
-        QString displayName = appConfig["name"].toString();
-        int order = appConfig["order"].toInt();
-        Common::Watchface watchface = Common::watchfaceFromString(appConfig["watchface"].toString());
-
-        if (id.isEmpty() ||
-            type == Common::Type::Unknown ||
-            displayName.isEmpty() ||
-            watchface == Common::Watchface::None) {
-            qWarning() << "Skipping creation of application with invalid metadata:" << appConfig;
-            continue;
-        }
-
-        // Create application
-        Common::Application* app = createApplication(id, type, displayName, order, watchface, media);
-        if (app) {
-            app->applyConfiguration(appConfig);
-            m_applications[id] = app;
-        }
-        else {
-            qWarning() << "Failed to create application:" << id << "of type:" << type;
+        if (Common::Application* app = createApplication(appConfig, media)) {
+            m_applications[app->id()] = app;
         }
     }
 
+    updateRetainedMedia(media);
     m_watchface->refresh();
 
+    m_loaded = true;
     setReloading(false);
 }
 
+void Container::update(const Services::Configuration::ConfigurationDelta& delta, Services::Configuration::Service& configuration, Services::Media::Service& media)
+{
+    // A delta is relative to a configuration that was never applied, start from scratch
+    if (!m_loaded) {
+        reload(configuration, media);
+        return;
+    }
+
+    if (!delta.changedSystemKeys.isEmpty()) {
+        qInfo() << "Applying changed system configuration keys:" << delta.changedSystemKeys.keys();
+        m_setup->applySystemConfiguration(delta.changedSystemKeys);
+    }
+    if (!delta.removedSystemKeys.isEmpty()) {
+        qInfo() << "Ignoring removed system configuration keys:" << delta.removedSystemKeys;
+    }
+
+    const bool structural = !delta.removedApplications.isEmpty() || !delta.addedApplications.isEmpty();
+    if (structural) {
+        setReloading(true);
+    }
+
+    const ApplicationDelta applied = ApplicationDelta::apply(delta, m_applications, [this, &media](const QJsonObject& appConfig) {
+        return createApplication(appConfig, media);
+    });
+
+    qInfo() << "Applications updated from configuration, created:" << applied.created << "destroyed:" << applied.destroyed << "updated:" << applied.updated;
+
+    if (applied.backgroundsChanged) {
+        updateRetainedMedia(media);
+    }
+    if (applied.rotationChanged) {
+        m_watchface->refresh();
+    }
+
+    if (structural) {
+        setReloading(false);
+    }
+}
+
+Common::Application* Container::createApplication(const QJsonObject& appConfig, Services::Media::Service& media)
+{
+    QString id = appConfig["id"].toString();
+    Common::Type type = Common::typeFromString(appConfig["type"].toString());
+    QString displayName = appConfig["name"].toString();
+    int order = appConfig["order"].toInt();
+    Common::Watchface watchface = Common::watchfaceFromString(appConfig["watchface"].toString());
+
+    if (id.isEmpty() ||
+        type == Common::Type::Unknown ||
+        displayName.isEmpty() ||
+        watchface == Common::Watchface::None) {
+        qWarning() << "Skipping creation of application with invalid metadata:" << appConfig;
+        return nullptr;
+    }
+
+    // Create application
+    Common::Application* app = createApplication(id, type, displayName, order, watchface, media);
+    if (!app) {
+        qWarning() << "Failed to create application:" << id << "of type:" << type;
+        return nullptr;
+    }
+
+    app->applyConfiguration(appConfig);
+    return app;
+}
+
+void Container::destroyApplication(const QString& id)
+{
+    Common::Application* app = m_applications.take(id);
+    if (app) {
+        qDebug() << "Destroying application:" << id;
+        delete app;
+    }
+}
+
+void Container::updateRetainedMedia(Services::Media::Service& media)
+{
+    // Keep the decoded backgrounds of enabled applications around between watchface rotations,
+    // and download them first, in rotation order.
+    QList<const Common::Application*> enabledApplications;
+    for (const Common::Application* app : std::as_const(m_applications)) {
+        if (app->configuration() && app->configuration()->enabled()) {
+            enabledApplications.append(app);
+        }
+    }
+    std::stable_sort(enabledApplications.begin(), enabledApplications.end(), [](const Common::Application* a, const Common::Application* b) {
+        return a->order() < b->order();
+    });
+
+    QStringList backgrounds;
+    for (const Common::Application* app : std::as_const(enabledApplications)) {
+        backgrounds.append(app->configuration()->background());
+    }
+    media.setRetainedMedia(backgrounds);
+}
+
 Common::Application* Container::createApplication(const QString& id, const Common::Type type, const QString& displayName, int order, Common::Watchface watchface, Services::Media::Service& media)
 {
     if (type == Common::Type::Clock) {
         return new Clock::Application(id, type, displayName, order, watchface, media, this);
     }
     else if (type == Common::Type::TimeElapsed) {
-        return new TimeElapsed::Application(id, type, displayName, order, watchface, media, this);
+        return new TimeElapsed::Application(id, type, displayName, order, watchface, media, m_dateTime, this);
     }
     else if (type == Common::Type::Countdown) {
-        return new Countdown::Application(id, type, displayName, order, watchface, media, this);
+        return new Countdown::Application(id, type, displayName, order, watchface, media, m_dateTime, this);
     }
     else {
         qWarning() << "Unknown application type:" << type;
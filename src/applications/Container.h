@@ -17,6 +17,11 @@ class Container;
 namespace Configuration
 {
 class Service;
+struct ConfigurationDelta;
+}
+namespace DateTime
+{
+class Service;
 }
 namespace Media
 {
@@ -44,6 +49,7 @@ class Container : public QObject
     Q_INVOKABLE Common::Application* application(const QString& id) const;
     QList<QString> applicationIds() const;
     bool reloading() const;
+    Watchface::Application* watchface() const;
 
   signals:
     void reloadingChanged();
@@ -53,10 +59,17 @@ class Container : public QObject
 
     // Factory method
     Common::Application* createApplication(const QString& id, Common::Type type, const QString& displayName, int order, Common::Watchface watchface, Services::Media::Service& media);
+    Common::Application* createApplication(const QJsonObject& appConfig, Services::Media::Service& media);
+    void destroyApplication(const QString& id);
     void reload(Services::Configuration::Service& configuration, Services::Media::Service& media);
+    void update(const Services::Configuration::ConfigurationDelta& delta, Services::Configuration::Service& configuration, Services::Media::Service& media);
+    void updateRetainedMedia(Services::Media::Service& media);
 
   private:
+    Services::DateTime::Service& m_dateTime;
+
     bool m_reloading = true;
+    bool m_loaded = false; // A configuration has been fully applied, later changes are applied as deltas
 
     // Dynamic applications (must be declared before core applications that reference it)
     Common::DynamicApplicationMap m_applications;
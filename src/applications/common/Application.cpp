@@ -37,6 +37,33 @@ Watchface Application::watchface() const
     return m_watchface;
 }
 
+Lifecycle Application::lifecycle() const
+{
+    return m_lifecycle;
+}
+
+void Application::setLifecycle(Lifecycle lifecycle)
+{
+    if (m_lifecycle == lifecycle) {
+        return;
+    }
+
+    const Lifecycle previous = m_lifecycle;
+    m_lifecycle = lifecycle;
+    qDebug() << "Application" << m_id << "is now" << lifecycleToString(lifecycle);
+    onLifecycleChanged(previous, lifecycle);
+    emit lifecycleChanged();
+}
+
+bool Application::active() const
+{
+    return m_lifecycle == Lifecycle::Active;
+}
+
+void Application::onLifecycleChanged(Lifecycle, Lifecycle)
+{
+}
+
 namespace Common
 {
 QDebug operator<<(QDebug debug, const Application& app)
@@ -23,6 +23,8 @@ class Application : public QObject
     Q_PROPERTY(QString displayName READ displayName CONSTANT)
     Q_PROPERTY(int order READ order CONSTANT)
     Q_PROPERTY(Common::Watchface watchface READ watchface CONSTANT)
+    Q_PROPERTY(Common::Lifecycle lifecycle READ lifecycle NOTIFY lifecycleChanged)
+    Q_PROPERTY(bool active READ active NOTIFY lifecycleChanged)
 
   public:
     explicit Application(const QString& id, Type type, const QString& displayName, int order, Watchface watchface, QObject* parent = nullptr);
@@ -35,6 +37,11 @@ class Application : public QObject
     int order() const;
     Watchface watchface() const;
 
+    // Lifecycle, driven by what is on screen. Applications start suspended.
+    Lifecycle lifecycle() const;
+    void setLifecycle(Lifecycle lifecycle);
+    bool active() const;
+
     // Apply configuration from JSON
     virtual void applyConfiguration(const QJsonObject& config) = 0;
 
@@ -43,12 +50,23 @@ class Application : public QObject
 
     friend QDebug operator<<(QDebug debug, const Application& app);
 
+  signals:
+    void lifecycleChanged();
+
+  protected:
+    /**
+     * Called on every lifecycle change, before lifecycleChanged() is emitted. Applications stop
+     * their periodic work when leaving Active and recompute their state when entering it.
+     */
+    virtual void onLifecycleChanged(Lifecycle previous, Lifecycle current);
+
   private:
     QString m_id;
     Type m_type;
     QString m_displayName;
     int m_order;
     Watchface m_watchface;
+    Lifecycle m_lifecycle = Lifecycle::Suspended;
 };
 
 } // namespace Common
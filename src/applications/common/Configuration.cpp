@@ -14,6 +14,13 @@ const QString PROPERTY_BASE_COLOR_KEY = QStringLiteral("base-color");
 const QColor PROPERTY_BASE_COLOR_DEFAULT = QColor("#02996c");
 const QString PROPERTY_ACCENT_COLOR_KEY = QStringLiteral("accent-color");
 const QColor PROPERTY_ACCENT_COLOR_DEFAULT = QColor("#BBBBBB");
+const QString PROPERTY_DWELL_TIME_KEY = QStringLiteral("dwell-time");
+const int PROPERTY_DWELL_TIME_DEFAULT = 10;
+const QString PROPERTY_ACTIVE_FROM_KEY = QStringLiteral("active-from");
+const QString PROPERTY_ACTIVE_UNTIL_KEY = QStringLiteral("active-until");
+const QString PROPERTY_WEIGHT_KEY = QStringLiteral("weight");
+const int PROPERTY_WEIGHT_DEFAULT = 1;
+const QString TIME_OF_DAY_FORMAT = QStringLiteral("HH:mm");
 
 Configuration::Configuration(const QString& name, QObject* parent)
     : QObject(parent),
@@ -22,7 +29,9 @@ Configuration::Configuration(const QString& name, QObject* parent)
       m_background(PROPERTY_BACKGROUND_DEFAULT),
       m_backgroundOpacity(PROPERTY_BACKGROUND_OPACITY_DEFAULT),
       m_baseColor(PROPERTY_BASE_COLOR_DEFAULT),
-      m_accentColor(PROPERTY_ACCENT_COLOR_DEFAULT)
+      m_accentColor(PROPERTY_ACCENT_COLOR_DEFAULT),
+      m_dwellTime(PROPERTY_DWELL_TIME_DEFAULT),
+      m_weight(PROPERTY_WEIGHT_DEFAULT)
 {
 }
 
@@ -37,6 +46,14 @@ QJsonObject Configuration::toJson() const
     json[PROPERTY_BASE_COLOR_KEY] = m_baseColor.name();
     json[PROPERTY_ACCENT_COLOR_KEY] = m_accentColor.name();
 
+    // Rotation schedule
+    json[PROPERTY_DWELL_TIME_KEY] = m_dwellTime;
+    if (m_activeFrom.isValid() && m_activeUntil.isValid()) {
+        json[PROPERTY_ACTIVE_FROM_KEY] = m_activeFrom.toString(TIME_OF_DAY_FORMAT);
+        json[PROPERTY_ACTIVE_UNTIL_KEY] = m_activeUntil.toString(TIME_OF_DAY_FORMAT);
+    }
+    json[PROPERTY_WEIGHT_KEY] = m_weight;
+
     return json;
 }
 
@@ -58,6 +75,20 @@ void Configuration::fromJson(const QJsonObject& json)
     if (json.contains(PROPERTY_ACCENT_COLOR_KEY)) {
         setAccentColor(QColor(json[PROPERTY_ACCENT_COLOR_KEY].toString()));
     }
+
+    // Rotation schedule
+    if (json.contains(PROPERTY_DWELL_TIME_KEY)) {
+        setDwellTime(json[PROPERTY_DWELL_TIME_KEY].toInt(PROPERTY_DWELL_TIME_DEFAULT));
+    }
+    if (json.contains(PROPERTY_ACTIVE_FROM_KEY)) {
+        setActiveFrom(QTime::fromString(json[PROPERTY_ACTIVE_FROM_KEY].toString(), TIME_OF_DAY_FORMAT));
+    }
+    if (json.contains(PROPERTY_ACTIVE_UNTIL_KEY)) {
+        setActiveUntil(QTime::fromString(json[PROPERTY_ACTIVE_UNTIL_KEY].toString(), TIME_OF_DAY_FORMAT));
+    }
+    if (json.contains(PROPERTY_WEIGHT_KEY)) {
+        setWeight(json[PROPERTY_WEIGHT_KEY].toInt(PROPERTY_WEIGHT_DEFAULT));
+    }
 }
 
 // Configuration accessors
@@ -137,6 +168,72 @@ void Configuration::setAccentColor(const QColor& accentColor)
     emit accentColorChanged();
 }
 
+int Configuration::dwellTime() const
+{
+    return m_dwellTime;
+}
+
+void Configuration::setDwellTime(const int& dwellTime)
+{
+    if (m_dwellTime == dwellTime) {
+        return;
+    }
+
+    m_dwellTime = dwellTime;
+    emit scheduleChanged();
+}
+
+QTime Configuration::activeFrom() const
+{
+    return m_activeFrom;
+}
+
+void Configuration::setActiveFrom(const QTime& activeFrom)
+{
+    if (m_activeFrom == activeFrom) {
+        return;
+    }
+
+    m_activeFrom = activeFrom;
+    emit scheduleChanged();
+}
+
+QTime Configuration::activeUntil() const
+{
+    return m_activeUntil;
+}
+
+void Configuration::setActiveUntil(const QTime& activeUntil)
+{
+    if (m_activeUntil == activeUntil) {
+        return;
+    }
+
+    m_activeUntil = activeUntil;
+    emit scheduleChanged();
+}
+
+int Configuration::weight() const
+{
+    return m_weight;
+}
+
+void Configuration::setWeight(const int& weight)
+{
+    if (m_weight == weight) {
+        return;
+    }
+
+    m_weight = weight;
+    emit scheduleChanged();
+}
+
+const QStringList& Configuration::scheduleKeys()
+{
+    static const QStringList keys = {PROPERTY_DWELL_TIME_KEY, PROPERTY_ACTIVE_FROM_KEY, PROPERTY_ACTIVE_UNTIL_KEY, PROPERTY_WEIGHT_KEY};
+    return keys;
+}
+
 Configuration& Configuration::operator=(const Configuration& other)
 {
     if (this != &other) {
@@ -146,6 +243,10 @@ Configuration& Configuration::operator=(const Configuration& other)
         setBackground(other.m_background);
         setBaseColor(other.m_baseColor);
         setAccentColor(other.m_accentColor);
+        setDwellTime(other.m_dwellTime);
+        setActiveFrom(other.m_activeFrom);
+        setActiveUntil(other.m_activeUntil);
+        setWeight(other.m_weight);
     }
     return *this;
 }
@@ -160,7 +261,11 @@ QDebug operator<<(QDebug debug, const Configuration& config)
                     << " - background=" << config.background() << "\n"
                     << " - backgroundOpacity=" << config.backgroundOpacity() << "\n"
                     << " - baseColor=" << config.baseColor().name() << "\n"
-                    << " - accentColor=" << config.accentColor().name() << ")";
+                    << " - accentColor=" << config.accentColor().name() << "\n"
+                    << " - dwellTime=" << config.dwellTime() << "\n"
+                    << " - activeFrom=" << config.activeFrom() << "\n"
+                    << " - activeUntil=" << config.activeUntil() << "\n"
+                    << " - weight=" << config.weight() << ")";
     return debug;
 }
 } // namespace Common
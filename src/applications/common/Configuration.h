@@ -4,6 +4,8 @@
 #include <QColor>
 #include <QDebug>
 #include <QObject>
+#include <QStringList>
+#include <QTime>
 
 namespace Common
 {
@@ -18,6 +20,12 @@ class Configuration : public QObject
     Q_PROPERTY(QColor baseColor READ baseColor WRITE setBaseColor NOTIFY baseColorChanged)
     Q_PROPERTY(QColor accentColor READ accentColor WRITE setAccentColor NOTIFY accentColorChanged)
 
+    // Rotation schedule properties
+    Q_PROPERTY(int dwellTime READ dwellTime WRITE setDwellTime NOTIFY scheduleChanged)
+    Q_PROPERTY(QTime activeFrom READ activeFrom WRITE setActiveFrom NOTIFY scheduleChanged)
+    Q_PROPERTY(QTime activeUntil READ activeUntil WRITE setActiveUntil NOTIFY scheduleChanged)
+    Q_PROPERTY(int weight READ weight WRITE setWeight NOTIFY scheduleChanged)
+
   public:
     Configuration(const QString& name, QObject* parent = nullptr);
 
@@ -39,6 +47,23 @@ class Configuration : public QObject
     QColor accentColor() const;
     void setAccentColor(const QColor& accentColor);
 
+    // Seconds the watchface stays on screen before the rotation moves on
+    int dwellTime() const;
+    void setDwellTime(const int& dwellTime);
+
+    // Time of day the watchface is part of the rotation, always when both are equal or invalid
+    QTime activeFrom() const;
+    void setActiveFrom(const QTime& activeFrom);
+    QTime activeUntil() const;
+    void setActiveUntil(const QTime& activeUntil);
+
+    // Number of turns per rotation cycle
+    int weight() const;
+    void setWeight(const int& weight);
+
+    // JSON keys that only affect the rotation schedule
+    static const QStringList& scheduleKeys();
+
     Configuration& operator=(const Configuration& other);
     friend QDebug operator<<(QDebug debug, const Configuration& config);
 
@@ -48,6 +73,7 @@ class Configuration : public QObject
     void backgroundChanged();
     void baseColorChanged();
     void accentColorChanged();
+    void scheduleChanged();
 
   protected:
     QString m_name;
@@ -58,6 +84,10 @@ class Configuration : public QObject
     QString m_background;
     QColor m_baseColor;
     QColor m_accentColor;
+    int m_dwellTime;
+    QTime m_activeFrom;
+    QTime m_activeUntil;
+    int m_weight;
 };
 } // namespace Common
 
@@ -96,6 +96,29 @@ inline QString watchfaceToString(Watchface watchface)
     }
 }
 
+// Visibility of an application, only active applications keep their state updating
+enum class Lifecycle
+{
+    Active,     // On screen
+    Background, // Current, but covered by a menu or dialog; resumes without delay
+    Suspended   // Not on screen
+};
+Q_ENUM_NS(Lifecycle)
+
+inline QString lifecycleToString(Lifecycle lifecycle)
+{
+    switch (lifecycle) {
+    case Lifecycle::Active:
+        return "active";
+    case Lifecycle::Background:
+        return "background";
+    case Lifecycle::Suspended:
+        return "suspended";
+    default:
+        return "unknown";
+    }
+}
+
 using DynamicApplicationMap = QMap<QString, Application*>;
 } // namespace Common
 
@@ -4,8 +4,11 @@
 #include "applications/common/Application.h"
 #include "applications/common/TimerConfiguration.h"
 #include <QObject>
-#include <QTimer>
 
+namespace Services::DateTime
+{
+class Service;
+}
 namespace Services::Media
 {
 class Service;
@@ -26,7 +29,7 @@ class Application : public Common::Application
     Q_PROPERTY(quint64 seconds READ seconds NOTIFY timeChanged)
 
   public:
-    Application(const QString& id, Common::Type type, const QString& displayName, int order, Common::Watchface watchface, Services::Media::Service& media, QObject* parent = nullptr);
+    Application(const QString& id, Common::Type type, const QString& displayName, int order, Common::Watchface watchface, Services::Media::Service& media, Services::DateTime::Service& dateTime, QObject* parent = nullptr);
 
     Common::TimerConfiguration* configuration() const override;
 
@@ -44,6 +47,9 @@ class Application : public Common::Application
     void startTimer();
     void stopTimer();
 
+  protected:
+    void onLifecycleChanged(Common::Lifecycle previous, Common::Lifecycle current) override;
+
   signals:
     void timeChanged();
     void yearsChanged(quint64 years);
@@ -67,6 +73,7 @@ class Application : public Common::Application
 
     Common::TimerConfiguration* m_configuration;
     Services::Media::Service& m_media;
+    Services::DateTime::Service& m_dateTime;
 
     // Properties for indicating the remaining time
     quint64 m_years;
@@ -77,7 +84,6 @@ class Application : public Common::Application
     quint64 m_minutes;
     quint64 m_seconds;
 
-    QTimer m_timer;
     bool m_finished;
 };
 } // namespace Applications::Countdown
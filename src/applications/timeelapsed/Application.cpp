@@ -1,4 +1,5 @@
 #include "Application.h"
+#include "services/datetime/Service.h"
 #include "services/media/Service.h"
 #include <QDateTime>
 #include <QDebug>
@@ -10,20 +11,21 @@ constexpr quint64 SECONDS_IN_A_DAY = SECONDS_IN_HOUR * 24;
 constexpr quint64 DAYS_IN_A_WEEK = 7;
 constexpr quint64 DAYS_IN_YEAR = 365;
 
-Application::Application(const QString& id, Common::Type type, const QString& displayName, int order, Common::Watchface watchface, Services::Media::Service& media, QObject* parent)
+Application::Application(const QString& id, Common::Type type, const QString& displayName, int order, Common::Watchface watchface, Services::Media::Service& media, Services::DateTime::Service& dateTime, QObject* parent)
     : Common::Application(id, type, displayName, order, watchface, parent),
       m_configuration(new Common::TimerConfiguration(id, parent)),
       m_media(media),
+      m_dateTime(dateTime),
       m_years(0),
       m_days(0),
       m_daysInWeek(0),
       m_weeks(0),
       m_hours(0),
       m_minutes(0),
-      m_seconds(0),
-      m_timer(this)
+      m_seconds(0)
 {
-    startTimer();
+    // Ticks only while active, see onLifecycleChanged()
+    calculateTimeElapsed();
 
     // Refresh background when media sync completes
     connect(&m_media, &Services::Media::Service::syncCompleted, this, [this]() {
@@ -54,18 +56,22 @@ void Application::applyConfiguration(const QJsonObject& configuration)
 void Application::startTimer()
 {
     calculateTimeElapsed();
-
-    if (!m_timer.isActive()) {
-        connect(&m_timer, &QTimer::timeout, this, &Application::calculateTimeElapsed);
-        m_timer.start(1000); // Update every second
-    }
+    connect(&m_dateTime, &Services::DateTime::Service::tick, this, &Application::calculateTimeElapsed, Qt::UniqueConnection);
 }
 
 void Application::stopTimer()
 {
-    if (m_timer.isActive()) {
-        disconnect(&m_timer, &QTimer::timeout, this, &Application::calculateTimeElapsed);
-        m_timer.stop();
+    disconnect(&m_dateTime, &Services::DateTime::Service::tick, this, &Application::calculateTimeElapsed);
+}
+
+void Application::onLifecycleChanged(Common::Lifecycle, Common::Lifecycle current)
+{
+    // Only ticks while on screen, resuming recomputes right away
+    if (current == Common::Lifecycle::Active) {
+        startTimer();
+    }
+    else {
+        stopTimer();
     }
 }
 
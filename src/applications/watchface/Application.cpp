@@ -1,11 +1,12 @@
 #include "Application.h"
-#include "applications/clock/Application.h"
-#include "applications/countdown/Application.h"
-#include "applications/timeelapsed/Application.h"
 
 #include <QDebug>
+#include <QQuickWindow>
 #include <algorithm>
 
+constexpr int PREWARM_LEAD_MS = 3000;         // Time to decode the next background on a worker before the switch
+constexpr int WINDOW_CHANGE_MARGIN_MS = 1000; // Wake up just after a time-of-day window boundary, not before it
+
 namespace Applications
 {
 namespace Watchface
@@ -14,17 +15,25 @@ Application::Application(const Common::DynamicApplicationMap& applications, QObj
     : QObject(parent),
       m_applications(applications),
       m_currentIndex(0),
-      m_rotationTimer(new QTimer(this))
+      m_shown(false),
+      m_covered(false),
+      m_rotationTimer(new QTimer(this)),
+      m_prewarmTimer(new QTimer(this)),
+      m_prewarming(false)
 {
     updateEnabledWatchfaces();
 
-    // Setup rotation timer (10 seconds)
-    m_rotationTimer->setInterval(10000);
+    // Both timers sleep until the next transition of the plan, see restartRotation()
+    m_rotationTimer->setSingleShot(true);
+    m_rotationTimer->setTimerType(Qt::PreciseTimer);
     connect(m_rotationTimer, &QTimer::timeout, this, &Application::rotateToNext);
 
-    if (!m_enabledWatchfaces.isEmpty()) {
-        m_rotationTimer->start();
-        qDebug() << "Watchface::Application initialized with" << m_enabledWatchfaces.size() << "enabled watchfaces";
+    m_prewarmTimer->setSingleShot(true);
+    connect(m_prewarmTimer, &QTimer::timeout, this, &Application::prewarm);
+
+    // Rotation starts once the watchfaces are shown, see setShown()
+    if (!m_plan.isEmpty()) {
+        qDebug() << "Watchface::Application initialized with" << m_plan.size() << "rotation slots";
     }
     else {
         qDebug() << "Watchface::Application: No enabled watchfaces found";
@@ -33,57 +42,111 @@ Application::Application(const Common::DynamicApplicationMap& applications, QObj
 
 Common::Application* Application::currentApp() const
 {
-    if (m_enabledWatchfaces.isEmpty() || m_currentIndex >= m_enabledWatchfaces.size()) {
+    if (m_currentIndex < 0 || m_currentIndex >= m_plan.size()) {
         return nullptr;
     }
-    return m_enabledWatchfaces[m_currentIndex];
+    return m_plan.slot(m_currentIndex).app;
+}
+
+Common::Application* Application::nextApp() const
+{
+    const int next = m_plan.step(m_currentIndex, 1, QTime::currentTime());
+    if (next < 0 || next == m_currentIndex || m_plan.slot(next).app == currentApp()) {
+        return nullptr;
+    }
+    return m_plan.slot(next).app;
+}
+
+bool Application::prewarming() const
+{
+    return m_prewarming;
+}
+
+void Application::measureRotations(QQuickWindow* window)
+{
+    connect(window, &QQuickWindow::frameSwapped, this, &Application::onFrameSwapped);
 }
 
 void Application::refresh()
 {
     updateEnabledWatchfaces();
+    restartRotation();
 
-    if (!m_enabledWatchfaces.isEmpty()) {
-        m_rotationTimer->start();
-        qDebug() << "Watchface::Application refreshed with" << m_enabledWatchfaces.size() << "enabled watchfaces";
+    if (!m_plan.isEmpty()) {
+        qDebug() << "Watchface::Application refreshed with" << m_plan.size() << "rotation slots";
     }
     else {
-        m_rotationTimer->stop();
         qDebug() << "Watchface::Application refreshed: No enabled watchfaces found";
     }
 
+    updateLifecycles();
     emit currentAppChanged();
 }
 
-void Application::nextWatchface()
+bool Application::shown() const
+{
+    return m_shown;
+}
+
+void Application::setShown(bool shown)
 {
-    if (m_enabledWatchfaces.isEmpty()) {
+    if (m_shown == shown) {
         return;
     }
 
-    m_currentIndex = (m_currentIndex + 1) % m_enabledWatchfaces.size();
-    emit currentAppChanged();
+    m_shown = shown;
+    updateLifecycles();
+    restartRotation();
+    emit shownChanged();
+}
+
+bool Application::covered() const
+{
+    return m_covered;
+}
+
+void Application::setCovered(bool covered)
+{
+    if (m_covered == covered) {
+        return;
+    }
 
-    // Restart timer
-    m_rotationTimer->start();
+    m_covered = covered;
+    updateLifecycles();
+    restartRotation();
+    emit coveredChanged();
+}
+
+void Application::nextWatchface()
+{
+    showSlot(m_plan.step(m_currentIndex, 1, QTime::currentTime()));
 }
 
 void Application::previousWatchface()
 {
-    if (m_enabledWatchfaces.isEmpty()) {
+    showSlot(m_plan.step(m_currentIndex, -1, QTime::currentTime()));
+}
+
+void Application::showSlot(int index)
+{
+    if (index < 0) {
         return;
     }
 
-    m_currentIndex = (m_currentIndex - 1 + m_enabledWatchfaces.size()) % m_enabledWatchfaces.size();
+    const bool changed = m_plan.slot(index).app != currentApp();
+    m_currentIndex = index;
+    if (changed) {
+        m_rotationLatency.start();
+        updateLifecycles();
+    }
     emit currentAppChanged();
 
-    // Restart timer
-    m_rotationTimer->start();
+    restartRotation();
 }
 
 void Application::updateEnabledWatchfaces()
 {
-    m_enabledWatchfaces.clear();
+    QList<Common::Application*> enabledWatchfaces;
 
     for (auto it = m_applications.constBegin(); it != m_applications.constEnd(); ++it) {
         Common::Application* app = it.value();
@@ -91,51 +154,116 @@ void Application::updateEnabledWatchfaces()
             continue;
         if (app->configuration() && !app->configuration()->enabled())
             continue;
-
-        switch (app->type()) {
-        case Common::Type::Clock: {
-            auto* castedApp = dynamic_cast<Applications::Clock::Application*>(app);
-            if (!castedApp) {
-                qDebug() << "Watchface: Failed to cast application" << it.key() << "to Clock::Application";
-                continue;
-            }
-
-            m_enabledWatchfaces.append(castedApp);
-        } break;
-
-        case Common::Type::TimeElapsed: {
-            auto* castedApp = dynamic_cast<Applications::TimeElapsed::Application*>(app);
-            if (!castedApp) {
-                qDebug() << "Watchface: Failed to cast application" << it.key() << "to TimeElapsed::Application";
-                continue;
-            }
-
-            m_enabledWatchfaces.append(castedApp);
-        } break;
-
-        case Common::Type::Countdown: {
-            auto* castedApp = dynamic_cast<Applications::Countdown::Application*>(app);
-            if (!castedApp) {
-                qDebug() << "Watchface: Failed to cast application" << it.key() << "to Countdown::Application";
-                continue;
-            }
-
-            m_enabledWatchfaces.append(castedApp);
-        } break;
-
-        case Common::Type::Unknown:
-        default:
+        if (app->type() == Common::Type::Unknown) {
             qDebug() << "Watchface: Application" << it.key() << "is not of any type, skipping";
             continue;
         }
-    }
 
-    m_currentIndex = 0;
+        enabledWatchfaces.append(app);
+    }
 
     // Sort by configured order
-    std::sort(m_enabledWatchfaces.begin(), m_enabledWatchfaces.end(), [](const Common::Application* a, const Common::Application* b) {
+    std::sort(enabledWatchfaces.begin(), enabledWatchfaces.end(), [](const Common::Application* a, const Common::Application* b) {
         return a->order() < b->order();
     });
+
+    m_plan = RotationPlan(enabledWatchfaces);
+    m_currentIndex = m_plan.step(-1, 1, QTime::currentTime());
+}
+
+void Application::updateLifecycles()
+{
+    // Only the current watchface is kept alive, it runs while nothing covers it
+    Common::Application* app = currentApp();
+    if (m_activeApp != app) {
+        if (m_activeApp) {
+            m_activeApp->setLifecycle(Common::Lifecycle::Suspended);
+        }
+        m_activeApp = app;
+    }
+
+    if (!m_activeApp) {
+        return;
+    }
+
+    if (!m_shown) {
+        m_activeApp->setLifecycle(Common::Lifecycle::Suspended);
+    }
+    else if (m_covered) {
+        m_activeApp->setLifecycle(Common::Lifecycle::Background);
+    }
+    else {
+        m_activeApp->setLifecycle(Common::Lifecycle::Active);
+    }
+}
+
+void Application::restartRotation()
+{
+    // A covered or hidden watchface keeps its turn, its full dwell time restarts once it is visible again
+    setPrewarming(false);
+    m_rotationTimer->stop();
+    m_prewarmTimer->stop();
+
+    if (!m_shown || m_covered || m_plan.isEmpty()) {
+        return;
+    }
+
+    // Sleep until the current turn ends, or until a time-of-day window changes which watchfaces take part.
+    // With a single watchface and no windows nothing ever changes, so nothing wakes up.
+    const QTime now = QTime::currentTime();
+    qint64 sleep = -1;
+    if (m_plan.eligibleCount(now) > 1 && m_currentIndex >= 0) {
+        sleep = m_plan.slot(m_currentIndex).dwellMs;
+    }
+
+    qint64 windowChange = m_plan.msecsToNextWindowChange(now);
+    if (windowChange >= 0) {
+        windowChange += WINDOW_CHANGE_MARGIN_MS;
+        if (sleep < 0 || windowChange < sleep) {
+            sleep = windowChange;
+        }
+    }
+
+    if (sleep < 0) {
+        return;
+    }
+
+    m_rotationTimer->start(std::chrono::milliseconds(sleep));
+    if (sleep > PREWARM_LEAD_MS && nextApp()) {
+        m_prewarmTimer->start(std::chrono::milliseconds(sleep - PREWARM_LEAD_MS));
+    }
+}
+
+void Application::setPrewarming(bool prewarming)
+{
+    if (m_prewarming != prewarming) {
+        m_prewarming = prewarming;
+        emit prewarmingChanged();
+    }
+}
+
+void Application::prewarm()
+{
+    if (!nextApp()) {
+        return;
+    }
+
+    // The UI starts its preparations synchronously from the change handlers, so this is their cost on the GUI thread
+    QElapsedTimer lTimer;
+    lTimer.start();
+    setPrewarming(true);
+    qDebug() << "Watchface: Prewarming" << nextApp()->id() << "took" << lTimer.elapsed() << "ms";
+}
+
+void Application::onFrameSwapped()
+{
+    if (!m_rotationLatency.isValid()) {
+        return;
+    }
+
+    const qint64 latency = m_rotationLatency.elapsed();
+    m_rotationLatency.invalidate();
+    qDebug() << "Watchface: Rotated to" << (currentApp() ? currentApp()->id() : QString()) << ", first frame after" << latency << "ms";
 }
 
 void Application::rotateToNext()
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <QElapsedTimer>
 #include <QObject>
+#include <QPointer>
 #include <QTimer>
 
 #include "../common/Application.h"
 #include "../common/Types.h"
+#include "RotationPlan.h"
+
+class QQuickWindow;
 
 namespace Applications
 {
@@ -14,29 +19,63 @@ class Application : public QObject
 {
     Q_OBJECT
     Q_PROPERTY(Common::Application* currentApp READ currentApp NOTIFY currentAppChanged)
+    Q_PROPERTY(Common::Application* nextApp READ nextApp NOTIFY currentAppChanged)
+    Q_PROPERTY(bool prewarming READ prewarming NOTIFY prewarmingChanged)
+    Q_PROPERTY(bool shown READ shown WRITE setShown NOTIFY shownChanged)
+    Q_PROPERTY(bool covered READ covered WRITE setCovered NOTIFY coveredChanged)
 
   public:
     Application(const Common::DynamicApplicationMap& applications, QObject* parent = nullptr);
 
     Common::Application* currentApp() const;
 
+    // Watchface the rotation switches to next, null when there is nothing to rotate to
+    Common::Application* nextApp() const;
+
+    // Set shortly before a rotation, the UI prepares nextApp() while it is
+    bool prewarming() const;
+
+    // Logs how long it takes until a rotation is on screen
+    void measureRotations(QQuickWindow* window);
+
     void refresh();
 
+    // Set from QML: whether the watchfaces are on screen and whether a menu or dialog covers them
+    bool shown() const;
+    void setShown(bool shown);
+    bool covered() const;
+    void setCovered(bool covered);
+
     Q_INVOKABLE void nextWatchface();
     Q_INVOKABLE void previousWatchface();
 
   signals:
     void currentAppChanged();
+    void shownChanged();
+    void coveredChanged();
+    void prewarmingChanged();
 
   private:
     void updateEnabledWatchfaces();
+    void showSlot(int index);
+    void updateLifecycles();
+    void restartRotation();
+    void setPrewarming(bool prewarming);
+    void prewarm();
+    void onFrameSwapped();
     void rotateToNext();
 
   private:
     const Common::DynamicApplicationMap& m_applications;
-    QList<Common::Application*> m_enabledWatchfaces;
-    int m_currentIndex;
+    RotationPlan m_plan;
+    int m_currentIndex; // Slot of m_plan, -1 when the plan is empty
+    QPointer<Common::Application> m_activeApp;
+    bool m_shown;
+    bool m_covered;
     QTimer* m_rotationTimer;
+    QTimer* m_prewarmTimer;
+    bool m_prewarming;
+    QElapsedTimer m_rotationLatency; // Valid from a rotation until its first frame is swapped
 };
 } // namespace Watchface
 } // namespace Applications
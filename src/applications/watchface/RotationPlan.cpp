@@ -0,0 +1,156 @@
+#include "RotationPlan.h"
+#include "../common/Configuration.h"
+
+#include <QDebug>
+#include <algorithm>
+
+constexpr int MIN_DWELL_MS = 2000; // Shorter turns are not readable
+constexpr int MAX_WEIGHT = 10;     // Keeps the cycle short
+constexpr int MSECS_PER_DAY = 24 * 60 * 60 * 1000;
+
+namespace Applications
+{
+namespace Watchface
+{
+RotationPlan::RotationPlan(const QList<Common::Application*>& applications)
+    : m_applications(applications)
+{
+    QList<Slot> entries;
+    QList<int> weights;
+    int totalWeight = 0;
+
+    for (Common::Application* app : applications) {
+        const Common::Configuration* configuration = app->configuration();
+        const QTime from = configuration ? configuration->activeFrom() : QTime();
+        const QTime until = configuration ? configuration->activeUntil() : QTime();
+        const bool windowed = from.isValid() && until.isValid() && from != until;
+
+        Slot slot;
+        slot.app = app;
+        slot.dwellMs = std::max(MIN_DWELL_MS, (configuration ? configuration->dwellTime() : 0) * 1000);
+        slot.fromMs = windowed ? from.msecsSinceStartOfDay() : 0;
+        slot.untilMs = windowed ? until.msecsSinceStartOfDay() : 0;
+        entries.append(slot);
+
+        const int weight = std::clamp(configuration ? configuration->weight() : 1, 1, MAX_WEIGHT);
+        weights.append(weight);
+        totalWeight += weight;
+    }
+
+    // Smooth weighted round robin: heavier watchfaces come back more often, without repeating back to back.
+    // Ties go to the earlier watchface, so equal weights keep the configured order.
+    QList<int> current(entries.size(), 0);
+    for (int turn = 0; turn < totalWeight; ++turn) {
+        int best = 0;
+        for (int i = 0; i < entries.size(); ++i) {
+            current[i] += weights[i];
+            if (current[i] > current[best]) {
+                best = i;
+            }
+        }
+        current[best] -= totalWeight;
+        m_slots.append(entries[best]);
+    }
+
+    qDebug() << "Watchface: Rotation plan of" << applications.size() << "watchfaces in" << m_slots.size() << "slots";
+}
+
+bool RotationPlan::isEmpty() const
+{
+    return m_slots.isEmpty();
+}
+
+int RotationPlan::size() const
+{
+    return m_slots.size();
+}
+
+const RotationPlan::Slot& RotationPlan::slot(int index) const
+{
+    return m_slots.at(index);
+}
+
+int RotationPlan::step(int index, int direction, const QTime& time) const
+{
+    if (m_slots.isEmpty()) {
+        return -1;
+    }
+
+    const int timeMs = time.msecsSinceStartOfDay();
+    const bool anyInWindow = this->anyInWindow(timeMs);
+    const int size = m_slots.size();
+
+    for (int offset = 1; offset <= size; ++offset) {
+        const int candidate = (((index + direction * offset) % size) + size) % size;
+        if (isEligible(m_slots.at(candidate), timeMs, anyInWindow)) {
+            return candidate;
+        }
+    }
+    return -1;
+}
+
+int RotationPlan::eligibleCount(const QTime& time) const
+{
+    const int timeMs = time.msecsSinceStartOfDay();
+    const bool anyInWindow = this->anyInWindow(timeMs);
+
+    int count = 0;
+    for (const Common::Application* app : m_applications) {
+        auto it = std::find_if(m_slots.cbegin(), m_slots.cend(), [app](const Slot& slot) {
+            return slot.app == app;
+        });
+        if (it != m_slots.cend() && isEligible(*it, timeMs, anyInWindow)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+qint64 RotationPlan::msecsToNextWindowChange(const QTime& time) const
+{
+    const int timeMs = time.msecsSinceStartOfDay();
+    qint64 next = -1;
+
+    for (const Slot& slot : m_slots) {
+        if (slot.fromMs == slot.untilMs) {
+            continue;
+        }
+
+        for (int boundary : {slot.fromMs, slot.untilMs}) {
+            qint64 msecs = ((boundary - timeMs) % MSECS_PER_DAY + MSECS_PER_DAY) % MSECS_PER_DAY;
+            if (msecs == 0) {
+                msecs = MSECS_PER_DAY;
+            }
+            if (next < 0 || msecs < next) {
+                next = msecs;
+            }
+        }
+    }
+    return next;
+}
+
+bool RotationPlan::inWindow(const Slot& slot, int timeMs)
+{
+    if (slot.fromMs == slot.untilMs) {
+        return true;
+    }
+    if (slot.fromMs < slot.untilMs) {
+        return timeMs >= slot.fromMs && timeMs < slot.untilMs;
+    }
+    return timeMs >= slot.fromMs || timeMs < slot.untilMs;
+}
+
+bool RotationPlan::isEligible(const Slot& slot, int timeMs, bool anyInWindow)
+{
+    // Rather show every watchface than none at all
+    return !anyInWindow || inWindow(slot, timeMs);
+}
+
+bool RotationPlan::anyInWindow(int timeMs) const
+{
+    return std::any_of(m_slots.cbegin(), m_slots.cend(), [timeMs](const Slot& slot) {
+        return inWindow(slot, timeMs);
+    });
+}
+} // namespace Watchface
+} // namespace Applications
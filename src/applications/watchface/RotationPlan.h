@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QList>
+#include <QTime>
+
+#include "../common/Application.h"
+
+namespace Applications
+{
+namespace Watchface
+{
+/**
+ * Order and timing of the watchface rotation, computed once per configuration change.
+ * Every watchface gets as many slots per cycle as its weight, spread evenly over the cycle.
+ * Watchfaces outside their time-of-day window are skipped, unless no watchface is inside its window.
+ */
+class RotationPlan
+{
+  public:
+    struct Slot
+    {
+        Common::Application* app;
+        int dwellMs;
+        int fromMs;  // Time of day the watchface is shown from, equal to untilMs when always shown
+        int untilMs; // Time of day the watchface is shown until, wraps past midnight when before fromMs
+    };
+
+    RotationPlan() = default;
+
+    /**
+     * Builds the plan of the given applications, which are expected in their configured order.
+     */
+    explicit RotationPlan(const QList<Common::Application*>& applications);
+
+    bool isEmpty() const;
+    int size() const;
+    const Slot& slot(int index) const;
+
+    /**
+     * Index of the first slot after index in the given direction (1 or -1) that may be shown at the given time.
+     * Returns index itself when it is the only one, -1 when the plan is empty.
+     */
+    int step(int index, int direction, const QTime& time) const;
+
+    // Number of distinct watchfaces that may be shown at the given time
+    int eligibleCount(const QTime& time) const;
+
+    // Milliseconds from the given time until a watchface enters or leaves its window, -1 without windows
+    qint64 msecsToNextWindowChange(const QTime& time) const;
+
+  private:
+    static bool inWindow(const Slot& slot, int timeMs);
+    static bool isEligible(const Slot& slot, int timeMs, bool anyInWindow);
+    bool anyInWindow(int timeMs) const;
+
+    QList<Slot> m_slots;
+    QList<Common::Application*> m_applications;
+};
+} // namespace Watchface
+} // namespace Applications
@@ -1,12 +1,13 @@
 #include "Container.h"
+#include "tracing/BootTrace.h"
 using namespace Drivers;
 
 Container::Container(QObject* parent)
     : QObject(parent),
-      m_storage(new Storage::Driver(this)),
-      m_network(new Network::Driver(this)),
-      m_screen(new Screen::Driver(this)),
-      m_system(new System::Driver(this)),
-      m_temperature(new Temperature::Driver(this))
+      m_storage(Tracing::traced("Storage::Driver", [this] { return new Storage::Driver(this); })),
+      m_network(Tracing::traced("Network::Driver", [this] { return new Network::Driver(this); })),
+      m_screen(Tracing::traced("Screen::Driver", [this] { return new Screen::Driver(this); })),
+      m_system(Tracing::traced("System::Driver", [this] { return new System::Driver(this); })),
+      m_temperature(Tracing::traced("Temperature::Driver", [this] { return new Temperature::Driver(this); }))
 {
 }
@@ -1,5 +1,6 @@
 #include "Driver.h"
 #include <QDebug>
+#include <QMetaMethod>
 using namespace Drivers::System;
 
 #ifdef PLATFORM_IS_TARGET
@@ -11,22 +12,13 @@ const QString SHUTDOWN_COMMAND = QStringLiteral("echo");
 const QStringList SHUTDOWN_ARGUMENTS = {QStringLiteral("System shutdown command not available on this platform")};
 const QString REBOOT_COMMAND = QStringLiteral("reboot");
 #endif
-constexpr int UPTIME_POLL_INTERVAL_MS = 1000; // 1 second
 
 Driver::Driver(QObject* parent)
     : QObject(parent),
       m_shutdownProcess(this),
-      m_rebootProcess(this),
-      m_uptimeTimer(this),
-      m_uptimeSeconds(0)
+      m_rebootProcess(this)
 {
-    m_uptimeTimer.setInterval(UPTIME_POLL_INTERVAL_MS);
-    m_uptimeTimer.setSingleShot(false);
-    connect(&m_uptimeTimer, &QTimer::timeout, this, [this]() {
-        m_uptimeSeconds++;
-        emit uptimeSecondsChanged();
-    });
-    m_uptimeTimer.start();
+    m_uptime.start();
 }
 
 void Driver::shutdown()
@@ -45,7 +37,39 @@ void Driver::reboot()
 
 uint64_t Driver::uptimeSeconds() const
 {
-    return m_uptimeSeconds;
+    return static_cast<uint64_t>(m_uptime.elapsed() / 1000);
+}
+
+bool Driver::uptimeWatched() const
+{
+    return m_uptimeWatched;
+}
+
+void Driver::connectNotify(const QMetaMethod& signal)
+{
+    if (signal == QMetaMethod::fromSignal(&Driver::uptimeSecondsChanged)) {
+        QMetaObject::invokeMethod(this, &Driver::updateUptimeWatched, Qt::QueuedConnection);
+    }
+}
+
+void Driver::disconnectNotify(const QMetaMethod& signal)
+{
+    // An invalid method means all signals were disconnected at once
+    if (!signal.isValid() || signal == QMetaMethod::fromSignal(&Driver::uptimeSecondsChanged)) {
+        QMetaObject::invokeMethod(this, &Driver::updateUptimeWatched, Qt::QueuedConnection);
+    }
+}
+
+// Deferred from (dis)connectNotify, where the connection is not necessarily (un)registered yet
+void Driver::updateUptimeWatched()
+{
+    const bool watched = isSignalConnected(QMetaMethod::fromSignal(&Driver::uptimeSecondsChanged));
+    if (watched == m_uptimeWatched) {
+        return;
+    }
+
+    m_uptimeWatched = watched;
+    emit uptimeWatchedChanged();
 }
 
 void Driver::onShutdownFinished()
@@ -1,9 +1,9 @@
 #ifndef DRIVERS_SYSTEM_DRIVER_H
 #define DRIVERS_SYSTEM_DRIVER_H
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QProcess>
-#include <QTimer>
 
 namespace Drivers::System
 {
@@ -18,19 +18,32 @@ class Driver : public QObject
     Q_INVOKABLE void shutdown();
     Q_INVOKABLE void reboot();
 
+    // Computed when read, without a timer of its own
     uint64_t uptimeSeconds() const;
 
+    /**
+     * Whether anything is connected to uptimeSecondsChanged(). The services emit it from the
+     * shared second tick only while it is watched.
+     */
+    bool uptimeWatched() const;
+
   signals:
     void uptimeSecondsChanged();
+    void uptimeWatchedChanged();
+
+  protected:
+    void connectNotify(const QMetaMethod& signal) override;
+    void disconnectNotify(const QMetaMethod& signal) override;
 
   private:
+    void updateUptimeWatched();
     void onShutdownFinished();
     void onRebootFinished();
 
     QProcess m_shutdownProcess;
     QProcess m_rebootProcess;
-    QTimer m_uptimeTimer;
-    uint64_t m_uptimeSeconds;
+    QElapsedTimer m_uptime;
+    bool m_uptimeWatched = false;
 };
 } // namespace Drivers::System
 
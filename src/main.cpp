@@ -1,6 +1,7 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
 
 #include "applications/Container.h"
 #include "applications/common/Types.h"
@@ -10,44 +11,59 @@
 #include "qmlcomponents/QmlUtils.h"
 #include "qmlcomponents/RoundAnimatedImage.h"
 #include "services/Container.h"
+#include "services/logging/Service.h"
+#include "tracing/BootTrace.h"
 
 int main(int argc, char* argv[])
 {
     Q_INIT_RESOURCE(icons);
 
+    // Keep every message in memory from the start, the logging service picks them up later
+    Services::Logging::Service::install();
+    Tracing::BootTrace::start();
+
     QGuiApplication app(argc, argv);
     app.setOrganizationName("bee");
     app.setApplicationName("clock-app");
 
     QQmlApplicationEngine engine;
-    QElapsedTimer lTimer;
-    lTimer.start();
 
-    Drivers::Container drivers(&app);
-    qDebug() << "Initialized Drivers in" << lTimer.restart() << "ms";
-    Services::Container services(drivers, &app);
-    qDebug() << "Initialized Services in" << lTimer.restart() << "ms";
-    Applications::Container applications(services, &app);
-    qDebug() << "Initialized Applications in" << lTimer.elapsed() << "ms";
+    Drivers::Container drivers = Tracing::traced("Drivers", [&] { return Drivers::Container(&app); });
+    Services::Container services = Tracing::traced("Services", [&] { return Services::Container(drivers, &app); });
+    {
+        Tracing::BootTrace::Span span("Wait for services");
+        services.waitUntilReady();
+    }
+    Applications::Container applications = Tracing::traced("Applications", [&] { return Applications::Container(services, &app); });
 
-    auto qmlInterface = services.qmlInterface();
-    qmlInterface->registerObject("QmlInterface", qmlInterface);
-    qmlInterface->registerObject("Drivers", &drivers);
-    qmlInterface->registerObject("Services", &services);
-    qmlInterface->registerObject("Applications", &applications);
-    qmlInterface->registerType<RoundAnimatedImage>("RoundAnimatedImage");
-    qmlInterface->registerType<QmlUtils>("QmlUtils");
-    qmlInterface->registerUncreatableType<Applications::Menu::Application>("MenuEnums");
-    qmlInterface->registerUncreatableType<Applications::Setup::Application>("SetupEnums");
+    {
+        Tracing::BootTrace::Span span("Register QML types", "qml");
+        auto qmlInterface = services.qmlInterface();
+        qmlInterface->registerObject("QmlInterface", qmlInterface);
+        qmlInterface->registerObject("Drivers", &drivers);
+        qmlInterface->registerObject("Services", &services);
+        qmlInterface->registerObject("Applications", &applications);
+        qmlInterface->registerType<RoundAnimatedImage>("RoundAnimatedImage");
+        qmlInterface->registerType<QmlUtils>("QmlUtils");
+        qmlInterface->registerUncreatableType<Applications::Menu::Application>("MenuEnums");
+        qmlInterface->registerUncreatableType<Applications::Setup::Application>("SetupEnums");
 
-    // Register Common namespace enums (Type, Watchface) for QML
-    qmlRegisterUncreatableMetaObject(
-        Common::staticMetaObject,
-        "Bee",
-        1,
-        0,
-        "Common",
-        "Access to Common enums only");
+        // Register namespace enums (Common: Type, Watchface, Logging: Level) for QML
+        qmlRegisterUncreatableMetaObject(
+            Common::staticMetaObject,
+            "Bee",
+            1,
+            0,
+            "Common",
+            "Access to Common enums only");
+        qmlRegisterUncreatableMetaObject(
+            Services::Logging::staticMetaObject,
+            "Bee",
+            1,
+            0,
+            "Logging",
+            "Access to Logging enums only");
+    }
 
     QObject::connect(
         &engine,
@@ -58,7 +74,26 @@ int main(int argc, char* argv[])
         },
         Qt::QueuedConnection);
 
-    engine.loadFromModule("Main", "Main");
+    {
+        Tracing::BootTrace::Span span("loadFromModule", "qml");
+        engine.loadFromModule("Main", "Main");
+    }
+
+    // Cold start ends with the first frame on screen, the trace is written once the startup checks are done as well
+    if (auto window = qobject_cast<QQuickWindow*>(engine.rootObjects().value(0))) {
+        QObject::connect(
+            window,
+            &QQuickWindow::frameSwapped,
+            &app,
+            []() {
+                Tracing::BootTrace::instant("First frame swapped");
+                Tracing::BootTrace::saveWhenIdle();
+            },
+            Qt::SingleShotConnection);
+
+        applications.watchface()->measureRotations(window);
+        services.metrics()->attach(window);
+    }
 
     quint32 lResult = app.exec();
 
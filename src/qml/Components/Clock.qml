@@ -22,21 +22,22 @@ Circle {
 	property alias secondColor: secondPointer.color
 
 	function timeChanged() {
-		var now = Bee.Services.dateTime.localTime
+		hours = Bee.Services.dateTime.hours
+		minutes = Bee.Services.dateTime.minutes
+		seconds = Bee.Services.dateTime.seconds
+	}
 
-		var parts = now.split(":");
+	// Shared second tick, only subscribed to while the clock is visible
+	Connections {
+		target: clock.visible ? Bee.Services.dateTime : null
 
-		hours = parseInt(parts[0]);
-		minutes = parseInt(parts[1]);
-		seconds = parseInt(parts[2]);
+		function onTick() {
+			clock.timeChanged()
+		}
 	}
 
-	Timer {
-		interval: 100
-		repeat: true
-		running: true
-		onTriggered: timeChanged()
-	}
+	Component.onCompleted: timeChanged()
+	onVisibleChanged: if (visible) timeChanged()
 
 	Rectangle {
 		id: minutePointer
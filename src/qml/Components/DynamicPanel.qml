@@ -12,11 +12,12 @@ Panel {
     property alias asynchronous: loader.asynchronous
     property alias dynamicContent: loader.item
     property bool keepLoaded: false
+    property bool preload: false // Create the content before the panel is shown
 
     Loader {
         id: loader
 
-        active: panel.visible
+        active: panel.visible || panel.preload
 
         asynchronous: true
         anchors.fill: parent
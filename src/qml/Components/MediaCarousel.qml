@@ -108,24 +108,34 @@ Item {
 
                     property bool isSelected: index === currentIndex
                     property string mediaName: model.filename
+                    property string thumbnailPath: model.thumbnailPath
 
-                    // Full screen media preview
-                    Backend.RoundAnimatedImage {
-                        id: previewImage
+                    // Small, pre-cropped still while scrolling past
+                    Image {
+                        id: thumbnailImage
                         anchors.fill: parent
-                        source: Backend.Services.media.getMediaPath(mediaName)
-                        opacity: 1.0
+                        source: thumbnailPath ? "file://" + thumbnailPath : ""
+                        asynchronous: true
+                        smooth: true
+                        visible: !previewLoader.active
+                    }
+
+                    // Full screen, animated media preview of the current page only
+                    Loader {
+                        id: previewLoader
+                        anchors.fill: parent
+                        active: isSelected || !thumbnailPath
 
-                        Behavior on opacity {
-                            NumberAnimation { duration: 300 }
+                        sourceComponent: Backend.RoundAnimatedImage {
+                            source: Backend.Services.media.getMediaPath(mediaName)
                         }
+                    }
 
-                        Circle {
-                            anchors.fill: parent
+                    Circle {
+                        anchors.fill: parent
 
-                            color: Color.black
-                            opacity: index == selectedIndex ? 0.5 : 0
-                        }
+                        color: Color.black
+                        opacity: index == selectedIndex ? 0.5 : 0
                     }
 
                     // Click to select
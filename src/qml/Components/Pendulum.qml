@@ -11,8 +11,11 @@ Item {
 	property alias bobColor: bob.color
 	property bool active: false
 
-	onActiveChanged: {
-		if (active) {
+	// The animation runs forever, so it only runs while it can be seen
+	readonly property bool running: active && visible
+
+	onRunningChanged: {
+		if (running) {
 			swingAnimation.start()
 		}
 		else {
@@ -27,6 +27,7 @@ Item {
 	readonly property string debugPanelTabHeaderInspector: qsTr("Inspector")
 	readonly property string debugPanelTabHeaderSimulation: qsTr("Simulation")
 	readonly property string debugPanelTabHeaderLogging: qsTr("Logging")
+	readonly property string debugPanelTabHeaderPerformance: qsTr("Performance")
 	readonly property string debugPanelGallerySimpleButtonText: qsTr("Button")
 	readonly property string debugPanelGalleryRoundButtonText: qsTr("Round button")
 	readonly property string debugPanelGalleryTextComponentText: qsTr("This is a simple text component.")
@@ -46,6 +47,17 @@ Item {
 	readonly property string debugPanelSimulationPanelActiveCountLabelText: qsTr("Active count: %1")
 	readonly property string debugPanelSimulationPanelHasActiveLabelText: qsTr("Has active: %1")
 	readonly property string debugPanelSimulationPanelIsVisibleLabelText: qsTr("Is visible: %1")
+	readonly property string debugPanelLoggingCategoryPlaceholderText: qsTr("Category")
+	readonly property string debugPanelLoggingFileLoggingText: qsTr("Write to file")
+	readonly property string debugPanelLoggingCountLabelText: qsTr("%1 entries")
+	readonly property string debugPanelPerformanceResetButtonText: qsTr("Reset")
+	readonly property string debugPanelPerformanceDumpButtonText: qsTr("Dump to file")
+	readonly property string debugPanelPerformanceFramesLabelText: qsTr("Frames: %1, dropped: %2")
+	readonly property string debugPanelPerformanceFrameTimeLabelText: qsTr("Frame time p50/p90/p99/max: %1 / %2 / %3 / %4 ms")
+	readonly property string debugPanelPerformanceSyncTimeLabelText: qsTr("Sync time p50/p99: %1 / %2 ms")
+	readonly property string debugPanelPerformanceRenderTimeLabelText: qsTr("Render time p50/p99: %1 / %2 ms")
+	readonly property string debugPanelPerformanceRepaintsLabelText: qsTr("%1: %2 repaints")
+	readonly property string debugPanelPerformanceDumpedLabelText: qsTr("Written to %1")
 
 	// Setup panel
 	readonly property string setupPanelWelcomeTitleText: qsTr("Welcome")
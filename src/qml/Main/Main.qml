@@ -2,6 +2,7 @@ import QtQuick
 
 import Components
 import Panels
+import Bee as Backend
 
 Window {
 	id: window
@@ -14,7 +15,10 @@ Window {
 
 	signal frontendReady()
 
-	onFrontendReady: panelContainer.showPanel(contentPanel)
+	onFrontendReady: {
+		Backend.QmlInterface.traceInstant("Frontend ready")
+		panelContainer.showPanel(contentPanel)
+	}
 
 	 PanelContainer {
         id: panelContainer
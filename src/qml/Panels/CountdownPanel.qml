@@ -117,6 +117,6 @@ RoundPanel {
 
     MouseArea {
 		anchors.fill: parent
-		onClicked: clockPanel.clicked()
+		onClicked: countdownPanel.clicked()
 	}
 }
\ No newline at end of file
@@ -1,4 +1,78 @@
 import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+import Components
+import Bee as Backend
 
 Item {
-}
\ No newline at end of file
+    id: logging
+
+    property var model: Backend.Services.logging.model
+
+    // Only follows new log entries while the debug panel is open
+    Component.onCompleted: model.live = true
+    Component.onDestruction: model.live = false
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: 10
+        spacing: 10
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 10
+
+            ComboBox {
+                model: ["Debug", "Info", "Warning", "Critical", "Fatal"]
+                currentIndex: logging.model.minimumLevel
+                onActivated: (index) => logging.model.minimumLevel = index
+            }
+
+            TextField {
+                Layout.fillWidth: true
+                placeholderText: Translation.debugPanelLoggingCategoryPlaceholderText
+                onTextChanged: logging.model.categoryFilter = text
+            }
+
+            CheckBox {
+                text: Translation.debugPanelLoggingFileLoggingText
+                checked: Backend.Services.logging.fileLogging
+                onToggled: Backend.Services.logging.fileLogging = checked
+            }
+
+            Text {
+                text: Translation.debugPanelLoggingCountLabelText.arg(logging.model.count)
+                color: "white"
+            }
+        }
+
+        ListView {
+            id: logView
+
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            clip: true
+            model: logging.model
+
+            // Stay at the newest entry unless scrolled back
+            property bool following: true
+            onMovementEnded: following = atYEnd
+            onCountChanged: if (following) positionViewAtEnd()
+
+            delegate: Text {
+                required property var timestamp
+                required property int level
+                required property string category
+                required property string message
+
+                width: logView.width
+                wrapMode: Text.Wrap
+                font.family: "monospace"
+                font.pixelSize: 12
+                text: Qt.formatTime(timestamp, "hh:mm:ss.zzz") + " " + category + ": " + message
+                color: level >= Backend.Logging.Level.Critical ? "red" : level === Backend.Logging.Level.Warning ? "orange" : level === Backend.Logging.Level.Info ? "white" : "lightgray"
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+import QtQuick
+import Components
+import Bee as Backend
+
+Item {
+    id: performance
+
+    property var metrics: Backend.Services.metrics
+    property string dumpedPath: ""
+
+    // Render metrics are only collected while the debug panel is open
+    Component.onCompleted: metrics.collecting = true
+    Component.onDestruction: metrics.collecting = false
+
+    Column {
+        spacing: 10
+        padding: 20
+
+        Row {
+            spacing: 10
+
+            Button {
+                text: Translation.debugPanelPerformanceResetButtonText
+                onClicked: performance.metrics.reset()
+            }
+
+            Button {
+                text: Translation.debugPanelPerformanceDumpButtonText
+                onClicked: performance.dumpedPath = performance.metrics.dump()
+            }
+        }
+
+        Text {
+            text: Translation.debugPanelPerformanceFramesLabelText.arg(performance.metrics.frames).arg(performance.metrics.droppedFrames)
+            color: "white"
+        }
+
+        Text {
+            text: Translation.debugPanelPerformanceFrameTimeLabelText
+                .arg(performance.metrics.frameTimeP50.toFixed(2))
+                .arg(performance.metrics.frameTimeP90.toFixed(2))
+                .arg(performance.metrics.frameTimeP99.toFixed(2))
+                .arg(performance.metrics.frameTimeMax.toFixed(2))
+            color: "white"
+        }
+
+        Text {
+            text: Translation.debugPanelPerformanceSyncTimeLabelText.arg(performance.metrics.syncTimeP50.toFixed(2)).arg(performance.metrics.syncTimeP99.toFixed(2))
+            color: "white"
+        }
+
+        Text {
+            text: Translation.debugPanelPerformanceRenderTimeLabelText.arg(performance.metrics.renderTimeP50.toFixed(2)).arg(performance.metrics.renderTimeP99.toFixed(2))
+            color: "white"
+        }
+
+        Repeater {
+            model: Object.keys(performance.metrics.repaints)
+
+            Text {
+                required property string modelData
+
+                text: Translation.debugPanelPerformanceRepaintsLabelText.arg(modelData).arg(performance.metrics.repaints[modelData])
+                color: "white"
+            }
+        }
+
+        Text {
+            visible: performance.dumpedPath !== ""
+            text: Translation.debugPanelPerformanceDumpedLabelText.arg(performance.dumpedPath)
+            color: "white"
+        }
+    }
+}
@@ -20,6 +20,7 @@ Rectangle {
 	// 	Inspector: drop down with all available objects in QML, on click it provides all the properties in this object.
 	// 	Simulation: simulate features of application
 	// 	Logging: show logs of application on screen
+	// 	Performance: frame times, dropped frames and repaint counts of the render loop
 	// 	HMI: Show additional HMI elements, animation speed, mouse events, keyboard events
 	// All tabs have toggle button to show panel in separate window
 
@@ -66,6 +67,9 @@ Rectangle {
 			TabButton {
 				text: Translation.debugPanelTabHeaderLogging
 			}
+			TabButton {
+				text: Translation.debugPanelTabHeaderPerformance
+			}
 		}
 
 		StackLayout {
@@ -78,6 +82,7 @@ Rectangle {
 			InspectorPanel {}
 			SimulationPanel {}
 			LoggingPanel {}
+			PerformancePanel {}
 		}
 	}
 }
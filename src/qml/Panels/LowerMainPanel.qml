@@ -19,6 +19,7 @@ Circle {
 
         PendulumPanel {
             id: pendulumPanel
+            covered: menuOverlay.visible
         }
     }
 
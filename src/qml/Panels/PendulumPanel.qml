@@ -10,12 +10,15 @@ RoundPanel {
 
     backgroundColor: Backend.Applications.setup.pendulumBackgroundColor
 
+    // Set while a menu dialog hides the pendulum
+    property bool covered: false
+
     Pendulum {
         id: pendulum
 
         bobColor: Backend.Applications.setup.pendulumBobColor
         rodColor: Backend.Applications.setup.pendulumRodColor
         anchors.fill: parent
-        active: Backend.Applications.setup.setupComplete || (!Backend.Applications.setup.setupComplete && Backend.Applications.setup.currentPanel === Backend.SetupEnums.Finish)
+        active: !pendulumPanel.covered && (Backend.Applications.setup.setupComplete || (!Backend.Applications.setup.setupComplete && Backend.Applications.setup.currentPanel === Backend.SetupEnums.Finish))
     }
 }
\ No newline at end of file
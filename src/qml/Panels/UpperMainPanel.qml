@@ -13,7 +13,7 @@ Circle {
         id: panelContainer
         anchors.fill: parent
 
-        property bool isLoading: Backend.Applications.reloading || Backend.Services.configuration.startupCheckInProgress || Backend.Services.media.startupCheckInProgress
+        property bool isLoading: Backend.Applications.reloading || Backend.Services.configuration.startupCheckInProgress || (Backend.Services.media.startupCheckInProgress && !Backend.Services.configuration.loadedFromCache)
         property Panel initialPanel: setupPanel.enabled ? setupPanel : watchfacesPanel
 
         currentIndex: {
@@ -22,15 +22,24 @@ Circle {
             return indexOfPanel(watchfacesPanel)
         }
 
-        SetupPanel {
+        // Only created while the setup is shown, most boots never need it
+        DynamicPanel {
             id: setupPanel
 
             anchors.fill: parent
             enabled: !Backend.Applications.setup.setupComplete
-            lowerMenuOverlay: upperMainPanel.lowerMenuOverlay
 
-            onFinished: {
-                panelContainer.showPanel(watchfacesPanel)
+            content: Component {
+                SetupPanel {
+                    shown: true
+                    transition: PanelTransition.none
+
+                    lowerMenuOverlay: upperMainPanel.lowerMenuOverlay
+
+                    onFinished: {
+                        panelContainer.showPanel(watchfacesPanel)
+                    }
+                }
             }
 
             onEnabledChanged: {
@@ -53,6 +62,19 @@ Circle {
         }
     }
 
+    // Drives the watchface lifecycle, only an uncovered watchface on screen keeps ticking and rotating
+    Binding {
+        target: Backend.Applications.watchface
+        property: "shown"
+        value: watchfacesPanel.visible
+    }
+
+    Binding {
+        target: Backend.Applications.watchface
+        property: "covered"
+        value: menuOverlay.visible || Backend.Applications.debug.panelEnabled
+    }
+
     UpperMenuOverlay {
         id: menuOverlay
 
@@ -8,10 +8,31 @@ Panel {
 
     property var currentApp: Backend.Applications.watchface.currentApp
     property bool currentAppValid: currentApp !== null && currentApp !== undefined
+    property var nextApp: Backend.Applications.watchface.nextApp
+    property bool nextAppValid: nextApp !== null && nextApp !== undefined
+    property bool prewarming: Backend.Applications.watchface.prewarming && nextAppValid
+
+    // App shown by the watchface panel of the given type. A panel prewarmed for the next app already shows it,
+    // when both apps share a type the panel stays on the current app and only the next background is prefetched.
+    function appFor(watchface) {
+        if (currentAppValid && currentApp.watchface === watchface)
+            return currentApp
+        if (nextAppValid && nextApp.watchface === watchface)
+            return nextApp
+        return currentApp
+    }
 
     signal clicked()
 
-    // Internal PanelContainer to manage watchface panels
+    // Shortly before a rotation the next watchface is created and its background decoded on a worker
+    onPrewarmingChanged: {
+        if (prewarming && nextApp.configuration) {
+            Backend.Services.media.prefetchFrames(nextApp.configuration.background,
+                                                  Qt.size(Math.round(width * Screen.devicePixelRatio), Math.round(height * Screen.devicePixelRatio)))
+        }
+    }
+
+    // Internal PanelContainer to manage watchface panels, a watchface is only loaded while it is shown or prewarmed
     PanelContainer {
         id: watchfaceContainer
         anchors.fill: parent
@@ -57,70 +78,118 @@ Panel {
         }
 
         // Clock Panel
-        ClockPanel {
+        DynamicPanel {
             id: clockPanel
 
-            onClicked: watchfacesPanel.clicked()
+            property var app: watchfacesPanel.appFor(Backend.Common.Watchface.AnalogClock)
+            property bool appValid: app !== null && app !== undefined
+
+            preload: watchfacesPanel.prewarming && watchfacesPanel.nextApp.watchface === Backend.Common.Watchface.AnalogClock
+
+            content: Component {
+                ClockPanel {
+                    shown: true
+                    transition: PanelTransition.none
 
-            backgroundImage: (currentAppValid && Backend.Services.media.getMediaPath(currentApp.configuration.background)) || ""
-            backgroundOpacity: (currentAppValid && currentApp.configuration.backgroundOpacity) || 0
-            backgroundColor: (currentAppValid && currentApp.configuration.baseColor) || "black"
-            hourColor: (currentAppValid && currentApp.configuration.hourColor) || "white"
-            minuteColor: (currentAppValid && currentApp.configuration.minuteColor) || "white"
-            secondColor: (currentAppValid && currentApp.configuration.secondColor) || "white"
+                    onClicked: watchfacesPanel.clicked()
+
+                    backgroundImage: (clockPanel.appValid && Backend.Services.media.getMediaPath(clockPanel.app.configuration.background)) || ""
+                    backgroundOpacity: (clockPanel.appValid && clockPanel.app.configuration.backgroundOpacity) || 0
+                    backgroundColor: (clockPanel.appValid && clockPanel.app.configuration.baseColor) || "black"
+                    hourColor: (clockPanel.appValid && clockPanel.app.configuration.hourColor) || "white"
+                    minuteColor: (clockPanel.appValid && clockPanel.app.configuration.minuteColor) || "white"
+                    secondColor: (clockPanel.appValid && clockPanel.app.configuration.secondColor) || "white"
+                }
+            }
         }
 
         // Seven Segment Panel
-        SevenSegmentPanel {
+        DynamicPanel {
             id: sevenSegmentPanel
 
-            initialized: (currentAppValid && currentApp.watchface === Backend.Common.Watchface.SevenSegment) ? (currentApp.configuration.initialized || false) : true
-            years: (currentApp && currentApp.years) || 0
-            days: (currentApp && currentApp.days) || 0
-            hours: (currentApp && currentApp.hours) || 0
-            minutes: (currentApp && currentApp.minutes) || 0
-            seconds: (currentApp && currentApp.seconds) || 0
-            onClicked: watchfacesPanel.clicked()
-
-            backgroundImage: (currentAppValid && Backend.Services.media.getMediaPath(currentApp.configuration.background)) || ""
-            backgroundOpacity: (currentAppValid && currentApp.configuration.backgroundOpacity) || 0
-            backgroundColor: (currentAppValid && currentApp.configuration.baseColor) || "black"
-            segmentColor: (currentAppValid && currentApp.configuration.accentColor) || "white"
+            property var app: watchfacesPanel.appFor(Backend.Common.Watchface.SevenSegment)
+            property bool appValid: app !== null && app !== undefined
+
+            preload: watchfacesPanel.prewarming && watchfacesPanel.nextApp.watchface === Backend.Common.Watchface.SevenSegment
+
+            content: Component {
+                SevenSegmentPanel {
+                    shown: true
+                    transition: PanelTransition.none
+
+                    initialized: (sevenSegmentPanel.appValid && sevenSegmentPanel.app.watchface === Backend.Common.Watchface.SevenSegment) ? (sevenSegmentPanel.app.configuration.initialized || false) : true
+                    years: (sevenSegmentPanel.app && sevenSegmentPanel.app.years) || 0
+                    days: (sevenSegmentPanel.app && sevenSegmentPanel.app.days) || 0
+                    hours: (sevenSegmentPanel.app && sevenSegmentPanel.app.hours) || 0
+                    minutes: (sevenSegmentPanel.app && sevenSegmentPanel.app.minutes) || 0
+                    seconds: (sevenSegmentPanel.app && sevenSegmentPanel.app.seconds) || 0
+                    onClicked: watchfacesPanel.clicked()
+
+                    backgroundImage: (sevenSegmentPanel.appValid && Backend.Services.media.getMediaPath(sevenSegmentPanel.app.configuration.background)) || ""
+                    backgroundOpacity: (sevenSegmentPanel.appValid && sevenSegmentPanel.app.configuration.backgroundOpacity) || 0
+                    backgroundColor: (sevenSegmentPanel.appValid && sevenSegmentPanel.app.configuration.baseColor) || "black"
+                    segmentColor: (sevenSegmentPanel.appValid && sevenSegmentPanel.app.configuration.accentColor) || "white"
+                }
+            }
         }
 
         // Round Progress Bar Panel
-        RoundProgressBarPanel {
+        DynamicPanel {
             id: roundProgressBarPanel
 
-            initialized: (currentAppValid && currentApp.watchface === Backend.Common.Watchface.RoundProgressBar) ? (currentApp.configuration.initialized || false) : true
-            years: (currentApp && currentApp.years) || 0
-            days: (currentApp && currentApp.days) || 0
-            daysInWeek: (currentApp && currentApp.daysInWeek) || 0
-            weeks: (currentApp && currentApp.weeks) || 0
-            hours: (currentApp && currentApp.hours) || 0
-            minutes: (currentApp && currentApp.minutes) || 0
-            seconds: (currentApp && currentApp.seconds) || 0
-            barColor: (currentAppValid && currentApp.configuration.baseColor) || "black"
-            textColor: (currentAppValid && currentApp.configuration.accentColor) || "white"
-            backgroundSource: (currentAppValid && Backend.Services.media.getMediaPath(currentApp.configuration.background)) || ""
-            backgroundOpacity: (currentAppValid && currentApp.configuration.backgroundOpacity) || 0
-            onClicked: watchfacesPanel.clicked()
+            property var app: watchfacesPanel.appFor(Backend.Common.Watchface.RoundProgressBar)
+            property bool appValid: app !== null && app !== undefined
+
+            preload: watchfacesPanel.prewarming && watchfacesPanel.nextApp.watchface === Backend.Common.Watchface.RoundProgressBar
+
+            content: Component {
+                RoundProgressBarPanel {
+                    shown: true
+                    transition: PanelTransition.none
+
+                    initialized: (roundProgressBarPanel.appValid && roundProgressBarPanel.app.watchface === Backend.Common.Watchface.RoundProgressBar) ? (roundProgressBarPanel.app.configuration.initialized || false) : true
+                    years: (roundProgressBarPanel.app && roundProgressBarPanel.app.years) || 0
+                    days: (roundProgressBarPanel.app && roundProgressBarPanel.app.days) || 0
+                    daysInWeek: (roundProgressBarPanel.app && roundProgressBarPanel.app.daysInWeek) || 0
+                    weeks: (roundProgressBarPanel.app && roundProgressBarPanel.app.weeks) || 0
+                    hours: (roundProgressBarPanel.app && roundProgressBarPanel.app.hours) || 0
+                    minutes: (roundProgressBarPanel.app && roundProgressBarPanel.app.minutes) || 0
+                    seconds: (roundProgressBarPanel.app && roundProgressBarPanel.app.seconds) || 0
+                    barColor: (roundProgressBarPanel.appValid && roundProgressBarPanel.app.configuration.baseColor) || "black"
+                    textColor: (roundProgressBarPanel.appValid && roundProgressBarPanel.app.configuration.accentColor) || "white"
+                    backgroundSource: (roundProgressBarPanel.appValid && Backend.Services.media.getMediaPath(roundProgressBarPanel.app.configuration.background)) || ""
+                    backgroundOpacity: (roundProgressBarPanel.appValid && roundProgressBarPanel.app.configuration.backgroundOpacity) || 0
+                    onClicked: watchfacesPanel.clicked()
+                }
+            }
         }
 
         // Countdown Panel
-        CountdownPanel {
+        DynamicPanel {
             id: countdownPanel
 
-            backgroundColor: (currentAppValid && currentApp.configuration.baseColor) || "black"
-            textColor: (currentAppValid && currentApp.configuration.accentColor) || "white"
-            backgroundSource: (currentAppValid && Backend.Services.media.getMediaPath(currentApp.configuration.background)) || ""
-            backgroundOpacity: (currentAppValid && currentApp.configuration.backgroundOpacity) || 0
-            initialized: (currentAppValid && currentApp.watchface === Backend.Common.Watchface.CountdownTimer) ? (currentApp.configuration.initialized || false) : true
-            days: (currentApp && currentApp.days) || 0
-            hours: (currentApp && currentApp.hours) || 0
-            minutes: (currentApp && currentApp.minutes) || 0
-            seconds: (currentApp && currentApp.seconds) || 0
-            onClicked: watchfacesPanel.clicked()
+            property var app: watchfacesPanel.appFor(Backend.Common.Watchface.CountdownTimer)
+            property bool appValid: app !== null && app !== undefined
+
+            preload: watchfacesPanel.prewarming && watchfacesPanel.nextApp.watchface === Backend.Common.Watchface.CountdownTimer
+
+            content: Component {
+                CountdownPanel {
+                    shown: true
+                    transition: PanelTransition.none
+
+                    backgroundColor: (countdownPanel.appValid && countdownPanel.app.configuration.baseColor) || "black"
+                    textColor: (countdownPanel.appValid && countdownPanel.app.configuration.accentColor) || "white"
+                    backgroundSource: (countdownPanel.appValid && Backend.Services.media.getMediaPath(countdownPanel.app.configuration.background)) || ""
+                    backgroundOpacity: (countdownPanel.appValid && countdownPanel.app.configuration.backgroundOpacity) || 0
+                    initialized: (countdownPanel.appValid && countdownPanel.app.watchface === Backend.Common.Watchface.CountdownTimer) ? (countdownPanel.app.configuration.initialized || false) : true
+                    days: (countdownPanel.app && countdownPanel.app.days) || 0
+                    hours: (countdownPanel.app && countdownPanel.app.hours) || 0
+                    minutes: (countdownPanel.app && countdownPanel.app.minutes) || 0
+                    seconds: (countdownPanel.app && countdownPanel.app.seconds) || 0
+                    onClicked: watchfacesPanel.clicked()
+                }
+            }
         }
     }
 }
@@ -1,15 +1,92 @@
-
 #include "RoundAnimatedImage.h"
-#include <QPainterPath>
+#include "services/metrics/Service.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGSimpleTextureNode>
+#include <QSGTexture>
+
+// Animations up to this size keep every frame on the GPU, larger ones only the current frame
+constexpr qint64 MAX_ANIMATION_TEXTURE_BYTES = 64 * 1024 * 1024;
+
+namespace
+{
+/**
+ * Scene graph node showing one (pre-scaled, pre-masked) frame at a time.
+ * Every frame is uploaded once, the first time it is shown, after which advancing the animation
+ * only swaps textures. Animations too large for MAX_ANIMATION_TEXTURE_BYTES keep a single texture
+ * and upload each frame as it is shown instead.
+ * Nodes are destroyed on the render thread, which is where the textures must be released.
+ */
+class FrameNode : public QSGSimpleTextureNode
+{
+  public:
+    FrameNode()
+        : m_generation(0),
+          m_frame(-1)
+    {
+        setOwnsTexture(false);
+        setFiltering(QSGTexture::Linear);
+    }
+
+    ~FrameNode() override
+    {
+        qDeleteAll(m_textures);
+    }
+
+    void showFrame(QQuickWindow* window, const Services::Media::Frames& frames, int index, quint64 generation)
+    {
+        if (generation != m_generation) {
+            qDeleteAll(m_textures);
+            m_textures.clear();
+            m_textures.resize(frames.bytes <= MAX_ANIMATION_TEXTURE_BYTES ? frames.images.size() : 1, nullptr);
+            m_generation = generation;
+            m_frame = -1;
+        }
+
+        if (index < 0 || index >= frames.images.size() || index == m_frame) {
+            return;
+        }
+
+        if (m_textures.size() == frames.images.size()) {
+            QSGTexture*& texture = m_textures[index];
+            if (!texture) {
+                texture = window->createTextureFromImage(frames.images.at(index));
+            }
+            setTexture(texture);
+        }
+        else {
+            QSGTexture* previous = m_textures.first();
+            m_textures.first() = window->createTextureFromImage(frames.images.at(index));
+            setTexture(m_textures.first());
+            delete previous;
+        }
+
+        m_frame = index;
+    }
+
+  private:
+    QList<QSGTexture*> m_textures; // Per frame, or only the current one for oversized animations
+    quint64 m_generation;
+    int m_frame;
+};
+} // namespace
 
 RoundAnimatedImage::RoundAnimatedImage(QQuickItem* parent)
-    : QQuickPaintedItem(parent),
-      m_movie(nullptr)
+    : QQuickItem(parent),
+      m_currentFrame(0),
+      m_framesGeneration(0),
+      m_framesDirty(false),
+      m_frameTimer(this)
 {
     setFlag(QQuickItem::ItemHasContents, true);
     setAcceptedMouseButtons(Qt::NoButton);
     setOpacity(1.0);
     setAntialiasing(true);
+
+    m_frameTimer.setSingleShot(true);
+    connect(&m_frameTimer, &QTimer::timeout, this, &RoundAnimatedImage::onFrameTimeout);
 }
 
 QString RoundAnimatedImage::source() const
@@ -19,102 +96,165 @@ QString RoundAnimatedImage::source() const
 
 void RoundAnimatedImage::setSource(const QString& path)
 {
-    // Store the original path
-    QString oldSource = m_source;
-    m_source = path;
-
-    // Convert qrc:/ to :/ for Qt resource compatibility, but use local variable
-    QString actualPath = path;
-    if (actualPath.startsWith("qrc:/")) {
-        actualPath.replace(0, 4, ":");
-    }
-
-    // Only skip reload if both the path and the actual loaded source are identical
-    // This allows reloading when files change on disk
-    if (oldSource == path && m_movie && m_movie->fileName() == actualPath) {
+    if (m_source == path && !m_framesDirty && m_frames) {
         return;
     }
 
+    m_source = path;
+    m_metricsLabel = QStringLiteral("RoundAnimatedImage %1").arg(QFileInfo(path).fileName());
     emit sourceChanged();
 
-    if (m_movie) {
-        m_movie->stop();
-        delete m_movie;
-        m_movie = nullptr;
-    }
+    // Decoding is deferred to the polish phase, at which point the final item size is known.
+    m_framesDirty = true;
+    polish();
+}
 
-    // Handle empty path gracefully
-    if (actualPath.isEmpty()) {
-        update(); // Clear the display
+void RoundAnimatedImage::onFrameTimeout()
+{
+    if (frameCount() < 2) {
         return;
     }
 
-    m_movie = new QMovie(actualPath);
-    if (!m_movie->isValid()) {
-        qWarning() << "Invalid movie source:" << actualPath;
-        delete m_movie;
-        m_movie = nullptr;
-        update(); // Clear the display
-        return;
-    }
-    connect(m_movie, &QMovie::frameChanged, this, &RoundAnimatedImage::onFrameChanged);
-    if (isVisible()) {
-        m_movie->start();
+    m_currentFrame = (m_currentFrame + 1) % frameCount();
+    m_frameTimer.start(m_frames->delays.at(m_currentFrame));
+    update(); // triggers updatePaintNode()
+}
+
+void RoundAnimatedImage::onFramesReady(const QString& path, const QSize& size)
+{
+    if (m_framesDirty && size == m_frameSize && path == Services::Media::FrameCache::localPath(m_source)) {
+        polish();
     }
 }
 
-void RoundAnimatedImage::onFrameChanged(int)
+void RoundAnimatedImage::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry)
 {
-    update(); // triggers paint()
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        m_framesDirty = true;
+        polish();
+    }
 }
 
 void RoundAnimatedImage::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData& value)
 {
-    QQuickPaintedItem::itemChange(change, value);
-    if (change == QQuickItem::ItemVisibleHasChanged && m_movie) {
-        if (isVisible()) {
-            if (m_movie->state() != QMovie::Running) {
-                m_movie->start();
-            }
+    QQuickItem::itemChange(change, value);
+    if (change == QQuickItem::ItemVisibleHasChanged) {
+        if (isVisible() && m_framesDirty) {
+            polish();
+        }
+        else if (isVisible()) {
+            startAnimation();
         }
         else {
-            m_movie->stop();
+            stopAnimation();
         }
     }
 }
 
-void RoundAnimatedImage::paint(QPainter* painter)
+void RoundAnimatedImage::updatePolish()
+{
+    if (m_framesDirty) {
+        loadFrames();
+        update();
+    }
+}
+
+QSGNode* RoundAnimatedImage::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*)
+{
+    auto* node = static_cast<FrameNode*>(oldNode);
+    Services::Metrics::Service::countRepaint(m_metricsLabel);
+
+    if (frameCount() == 0) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new FrameNode();
+    }
+
+    node->showFrame(window(), *m_frames, m_currentFrame, m_framesGeneration);
+    node->setRect(boundingRect());
+    return node;
+}
+
+void RoundAnimatedImage::loadFrames()
 {
-    QRectF bounds = boundingRect();
+    m_framesDirty = false;
+    stopAnimation();
+
+    m_frames.reset();
+    m_currentFrame = 0;
 
-    // Enable antialiasing for smooth circle
-    painter->setRenderHint(QPainter::Antialiasing, true);
+    const qreal devicePixelRatio = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+    m_frameSize = (size() * devicePixelRatio).toSize();
+    if (m_frameSize.isEmpty()) {
+        return;
+    }
 
-    // Create circular clip
-    QPainterPath path;
-    path.addEllipse(bounds);
-    painter->setClipPath(path);
+    const QString actualPath = Services::Media::FrameCache::localPath(m_source);
+    auto* cache = Services::Media::FrameCache::instance();
 
-    if (m_movie && m_movie->isValid()) {
-        QImage frame = m_movie->currentImage();
-        if (frame.isNull()) {
-            // Draw black background for null frame
-            painter->fillRect(bounds, Qt::black);
+    if (cache && !actualPath.isEmpty()) {
+        // Hidden images (e.g. a preloaded watchface) decode in the background and pick the frames up once shown
+        if (!isVisible() && !cache->contains(actualPath, m_frameSize)) {
+            cache->prefetch(actualPath, m_frameSize);
+            m_framesDirty = true;
             return;
         }
 
-        // Scale the frame to fill the bounding rect, keeping aspect ratio
-        QImage scaledFrame = frame.scaled(bounds.size().toSize(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+        // Shared with every other image showing the same media at the same size. A miss is decoded on a
+        // worker, the background stays black until it delivers the frames.
+        m_frames = cache->frames(actualPath, m_frameSize);
+        if (!m_frames && cache->isPrefetching(actualPath, m_frameSize)) {
+            m_framesDirty = true;
+            connect(cache, &Services::Media::FrameCache::framesReady, this, &RoundAnimatedImage::onFramesReady, Qt::UniqueConnection);
+        }
+    }
+    else if (!actualPath.isEmpty()) {
+        m_frames = Services::Media::FrameCache::decode(actualPath, m_frameSize);
+    }
 
-        // Center the image if aspect ratio does not match
-        QPointF topLeft(
-            bounds.x() + (bounds.width() - scaledFrame.width()) / 2,
-            bounds.y() + (bounds.height() - scaledFrame.height()) / 2);
+    if (!m_frames) {
+        // Draw black background when there's no valid source
+        QImage background(m_frameSize, QImage::Format_ARGB32_Premultiplied);
+        background.fill(Qt::transparent);
 
-        painter->drawImage(bounds, frame);
+        QPainter painter(&background);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Qt::black);
+        painter.drawEllipse(QRectF(QPointF(0, 0), QSizeF(m_frameSize)));
+        painter.end();
+
+        auto frames = QSharedPointer<Services::Media::Frames>::create();
+        frames->images.append(background);
+        frames->delays.append(0);
+        frames->bytes = background.sizeInBytes();
+        m_frames = frames;
     }
-    else {
-        // Draw black background when there's no valid movie source
-        painter->fillRect(bounds, Qt::black);
+
+    ++m_framesGeneration;
+
+    if (isVisible()) {
+        startAnimation();
     }
 }
+
+void RoundAnimatedImage::startAnimation()
+{
+    if (frameCount() > 1 && !m_frameTimer.isActive()) {
+        m_frameTimer.start(m_frames->delays.at(m_currentFrame));
+    }
+}
+
+void RoundAnimatedImage::stopAnimation()
+{
+    m_frameTimer.stop();
+}
+
+int RoundAnimatedImage::frameCount() const
+{
+    return m_frames ? m_frames->images.size() : 0;
+}
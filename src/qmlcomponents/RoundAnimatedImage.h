@@ -1,15 +1,18 @@
-#include <QMovie>
-#include <QPainter>
-#include <QQuickPaintedItem>
+#pragma once
 
-class RoundAnimatedImage : public QQuickPaintedItem
+#include <QQuickItem>
+#include <QSharedPointer>
+#include <QTimer>
+
+#include "services/media/FrameCache.h"
+
+class RoundAnimatedImage : public QQuickItem
 {
     Q_OBJECT
     Q_PROPERTY(QString source READ source WRITE setSource NOTIFY sourceChanged)
 
   public:
     RoundAnimatedImage(QQuickItem* parent = nullptr);
-    void paint(QPainter* painter) override;
 
     QString source() const;
     void setSource(const QString& path);
@@ -18,12 +21,27 @@ class RoundAnimatedImage : public QQuickPaintedItem
     void sourceChanged();
 
   private slots:
-    void onFrameChanged(int frameNumber);
+    void onFrameTimeout();
+    void onFramesReady(const QString& path, const QSize& size);
 
   protected:
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+    void updatePolish() override;
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
     void itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData& value) override;
 
   private:
-    QMovie* m_movie;
+    void loadFrames();
+    void startAnimation();
+    void stopAnimation();
+    int frameCount() const;
+
     QString m_source;
+    QString m_metricsLabel; // Identifies the image in the repaint counts
+    QSize m_frameSize;
+    QSharedPointer<const Services::Media::Frames> m_frames;
+    int m_currentFrame;
+    quint64 m_framesGeneration; // Bumped whenever m_frames is replaced, so the node uploads the new frame
+    bool m_framesDirty;
+    QTimer m_frameTimer;
 };
@@ -1,23 +1,53 @@
 #include "Container.h"
 #include "datetime/Service.h"
 #include "drivers/Container.h"
+#include "tracing/BootTrace.h"
 using namespace Services;
 
 Container::Container(Drivers::Container& drivers, QObject* parent)
     : QObject(parent),
-      m_version(new Version::Service(this)),
-      m_rest(new Rest::Service(*drivers.m_network, this)),
-      m_websocket(new WebSocket::Service(*drivers.m_network, this)),
-      m_notification(new Notification::Service(this)),
-      m_media(new Media::Service(*m_websocket, *m_rest, this)),
-      m_systemMonitor(new SystemMonitor::Service(*m_websocket, *drivers.m_temperature, *drivers.m_system, *m_version, *m_notification, this)),
-      m_configuration(new Configuration::Service(*m_websocket, this)),
-      m_dateTime(new DateTime::Service(this)),
-      m_qmlInterface(new QmlInterface::Service(this))
+      m_initializer(new Initializer(this)),
+      m_version(Tracing::traced("Version::Service", [&] { return new Version::Service(this); })),
+      m_rest(Tracing::traced("Rest::Service", [&] { return new Rest::Service(*drivers.m_network, this); })),
+      m_websocket(Tracing::traced("WebSocket::Service", [&] { return new WebSocket::Service(*drivers.m_network, this); })),
+      m_notification(Tracing::traced("Notification::Service", [&] { return new Notification::Service(this); })),
+      m_media(Tracing::traced("Media::Service", [&] { return new Media::Service(*m_websocket, *m_rest, this); })),
+      m_systemMonitor(Tracing::traced("SystemMonitor::Service", [&] { return new SystemMonitor::Service(*m_websocket, *drivers.m_temperature, *drivers.m_system, *m_version, *m_notification, this); })),
+      m_configuration(Tracing::traced("Configuration::Service", [&] { return new Configuration::Service(*m_websocket, this); })),
+      m_dateTime(Tracing::traced("DateTime::Service", [&] { return new DateTime::Service(this); })),
+      m_qmlInterface(Tracing::traced("QmlInterface::Service", [&] { return new QmlInterface::Service(this); })),
+      m_metrics(Tracing::traced("Metrics::Service", [&] { return new Metrics::Service(this); })),
+      m_logging(Tracing::traced("Logging::Service", [&] { return new Logging::Service(this); }))
 {
+    // Heavy startup work of the services runs concurrently on a thread pool
+    m_configuration->addInitializationSteps(*m_initializer);
+    m_media->addInitializationSteps(*m_initializer);
+    m_initializer->start();
+
+    // The uptime is computed when read, the shared second tick only notifies bindings to it
+    Drivers::System::Driver* system = drivers.m_system;
+    connect(system, &Drivers::System::Driver::uptimeWatchedChanged, this, [this, system]() {
+        if (system->uptimeWatched()) {
+            connect(m_dateTime, &DateTime::Service::tick, system, &Drivers::System::Driver::uptimeSecondsChanged, Qt::UniqueConnection);
+        }
+        else {
+            disconnect(m_dateTime, &DateTime::Service::tick, system, &Drivers::System::Driver::uptimeSecondsChanged);
+        }
+    });
 }
 
 QmlInterface::Service* Container::qmlInterface() const
 {
     return m_qmlInterface;
 }
+
+Metrics::Service* Container::metrics() const
+{
+    return m_metrics;
+}
+
+void Container::waitUntilReady()
+{
+    // Applications are created from the configuration, everything else can finish after the UI is up
+    m_initializer->waitFor({Configuration::Service::INITIALIZATION_STEP});
+}
@@ -3,9 +3,12 @@
 
 #include <QObject>
 
+#include "Initializer.h"
 #include "configuration/Service.h"
 #include "datetime/Service.h"
+#include "logging/Service.h"
 #include "media/Service.h"
+#include "metrics/Service.h"
 #include "notification/Service.h"
 #include "qmlinterface/Service.h"
 #include "rest/Service.h"
@@ -37,14 +40,23 @@ class Container : public QObject
     Q_PROPERTY(Services::WebSocket::Service* websocket MEMBER m_websocket CONSTANT)
     Q_PROPERTY(Services::SystemMonitor::Service* systemMonitor MEMBER m_systemMonitor CONSTANT)
     Q_PROPERTY(Services::Configuration::Service* configuration MEMBER m_configuration CONSTANT)
+    Q_PROPERTY(Services::Metrics::Service* metrics MEMBER m_metrics CONSTANT)
+    Q_PROPERTY(Services::Logging::Service* logging MEMBER m_logging CONSTANT)
   public:
     friend class ::Applications::Container;
 
     Container(Drivers::Container& drivers, QObject* parent = nullptr);
 
     QmlInterface::Service* qmlInterface() const;
+    Metrics::Service* metrics() const;
+
+    /**
+     * Block until the services the UI depends on are initialized, the rest continues in the background.
+     */
+    void waitUntilReady();
 
   private:
+    Initializer* m_initializer;
     Version::Service* m_version;
     Rest::Service* m_rest;
     WebSocket::Service* m_websocket;
@@ -54,6 +66,8 @@ class Container : public QObject
     Configuration::Service* m_configuration;
     DateTime::Service* m_dateTime;
     QmlInterface::Service* m_qmlInterface;
+    Metrics::Service* m_metrics;
+    Logging::Service* m_logging;
 };
 } // namespace Services
 
@@ -0,0 +1,145 @@
+#include "Initializer.h"
+#include "tracing/BootTrace.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+
+using namespace Services;
+
+Initializer::Initializer(QObject* parent)
+    : QObject(parent)
+{
+}
+
+Initializer::~Initializer()
+{
+    m_pool.waitForDone();
+}
+
+void Initializer::addStep(const char* name, const QList<const char*>& dependencies, Work work, Work apply)
+{
+    if (m_started) {
+        qWarning() << "Cannot add initialization step" << name << "after initialization started";
+        return;
+    }
+
+    Step step;
+    step.name = name;
+    step.dependencies = dependencies;
+    step.work = std::move(work);
+    step.apply = std::move(apply);
+    m_steps.insert(QByteArray(name), step);
+    ++m_pending;
+}
+
+void Initializer::start()
+{
+    m_started = true;
+    for (const Step& step : std::as_const(m_steps)) {
+        for (const char* dependency : step.dependencies) {
+            if (!m_steps.contains(QByteArray(dependency))) {
+                qWarning() << "Initialization step" << step.name << "depends on unknown step" << dependency;
+            }
+        }
+    }
+
+    launchReadySteps();
+}
+
+void Initializer::waitFor(const QList<const char*>& names)
+{
+    for (const char* name : names) {
+        const QByteArray key(name);
+        if (!m_steps.contains(key)) {
+            qWarning() << "Cannot wait for unknown initialization step" << name;
+            continue;
+        }
+
+        if (m_steps[key].ready) {
+            continue;
+        }
+
+        // Dependencies first, finishing them launches this step
+        waitFor(m_steps[key].dependencies);
+
+        Step& step = m_steps[key];
+        if (!step.started) {
+            launch(step);
+        }
+
+        QElapsedTimer lTimer;
+        lTimer.start();
+        QFuture<void> future = step.future;
+        future.waitForFinished();
+        if (lTimer.elapsed() > 0) {
+            qDebug() << "Waited" << lTimer.elapsed() << "ms for initialization step" << name;
+        }
+        finish(key);
+    }
+}
+
+bool Initializer::isReady(const char* name) const
+{
+    return m_steps.value(QByteArray(name)).ready;
+}
+
+void Initializer::launchReadySteps()
+{
+    for (Step& step : m_steps) {
+        if (step.started) {
+            continue;
+        }
+
+        bool dependenciesReady = true;
+        for (const char* dependency : std::as_const(step.dependencies)) {
+            if (!m_steps.value(QByteArray(dependency)).ready) {
+                dependenciesReady = false;
+                break;
+            }
+        }
+
+        if (dependenciesReady) {
+            launch(step);
+        }
+    }
+}
+
+void Initializer::launch(Step& step)
+{
+    step.started = true;
+    step.future = QtConcurrent::run(&m_pool, [name = step.name, work = step.work]() {
+        Tracing::BootTrace::Span span(name, "init");
+        work();
+    });
+
+    // Applied from the event loop, unless waitFor() got there first
+    step.future.then(this, [this, key = QByteArray(step.name)]() {
+        finish(key);
+    });
+}
+
+void Initializer::finish(const QByteArray& name)
+{
+    Step& step = m_steps[name];
+    if (step.ready) {
+        return;
+    }
+
+    step.ready = true;
+    if (step.apply) {
+        Tracing::BootTrace::Span span(step.name, "init");
+        step.apply();
+    }
+
+    qDebug() << "Initialization step" << step.name << "ready";
+    emit stepReady(QString::fromUtf8(name));
+
+    --m_pending;
+    if (m_pending == 0) {
+        qInfo() << "Initialization complete";
+        emit finished();
+        return;
+    }
+
+    launchReadySteps();
+}
@@ -0,0 +1,70 @@
+#ifndef SERVICES_INITIALIZER_H
+#define SERVICES_INITIALIZER_H
+
+#include <QByteArray>
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QThreadPool>
+#include <functional>
+
+namespace Services
+{
+/**
+ * Initialization graph for the heavy parts of service startup (file reads, parsing).
+ * Each step runs on a worker thread once its dependencies are ready, followed by an
+ * optional apply part on the thread of the initializer. The work part may only touch
+ * state that nothing else uses until the step is ready.
+ */
+class Initializer : public QObject
+{
+    Q_OBJECT
+
+  public:
+    using Work = std::function<void()>;
+
+    explicit Initializer(QObject* parent = nullptr);
+    ~Initializer() override;
+
+    /**
+     * Declare a step. Names are kept by pointer for tracing, so they must be string literals.
+     */
+    void addStep(const char* name, const QList<const char*>& dependencies, Work work, Work apply = Work());
+
+    void start();
+
+    /**
+     * Block until the given steps (and so their dependencies) are ready and applied.
+     */
+    void waitFor(const QList<const char*>& names);
+    bool isReady(const char* name) const;
+
+  signals:
+    void stepReady(const QString& name);
+    void finished();
+
+  private:
+    struct Step
+    {
+        const char* name = nullptr;
+        QList<const char*> dependencies;
+        Work work;
+        Work apply;
+        QFuture<void> future;
+        bool started = false;
+        bool ready = false;
+    };
+
+    void launchReadySteps();
+    void launch(Step& step);
+    void finish(const QByteArray& name);
+
+    QThreadPool m_pool;
+    QHash<QByteArray, Step> m_steps;
+    bool m_started = false;
+    int m_pending = 0;
+};
+} // namespace Services
+
+#endif // SERVICES_INITIALIZER_H
@@ -0,0 +1,94 @@
+#include "ConfigurationDelta.h"
+#include "DeviceConfiguration.h"
+#include <QHash>
+#include <QSet>
+
+using namespace Services::Configuration;
+
+// Application fields that are fixed for the lifetime of an application object
+const QStringList APPLICATION_METADATA_KEYS = {
+    QStringLiteral("type"),
+    QStringLiteral("name"),
+    QStringLiteral("order"),
+    QStringLiteral("watchface"),
+};
+
+bool ConfigurationDelta::isEmpty() const
+{
+    return changedSystemKeys.isEmpty() &&
+           removedSystemKeys.isEmpty() &&
+           addedApplications.isEmpty() &&
+           changedApplications.isEmpty() &&
+           removedApplications.isEmpty();
+}
+
+ConfigurationDelta ConfigurationDelta::compute(const DeviceConfiguration& previous, const DeviceConfiguration& current)
+{
+    ConfigurationDelta delta;
+
+    // System configuration, per key
+    for (auto it = current.systemConfiguration.constBegin(); it != current.systemConfiguration.constEnd(); ++it) {
+        if (previous.systemConfiguration.value(it.key()) != it.value()) {
+            delta.changedSystemKeys.insert(it.key(), it.value());
+        }
+    }
+    for (auto it = previous.systemConfiguration.constBegin(); it != previous.systemConfiguration.constEnd(); ++it) {
+        if (!current.systemConfiguration.contains(it.key())) {
+            delta.removedSystemKeys.append(it.key());
+        }
+    }
+
+    // Applications, per id
+    QHash<QString, const QJsonObject*> previousApplications;
+    for (const QJsonObject& appConfig : previous.applications) {
+        previousApplications.insert(appConfig["id"].toString(), &appConfig);
+    }
+
+    QSet<QString> currentIds;
+    for (const QJsonObject& appConfig : current.applications) {
+        const QString id = appConfig["id"].toString();
+        currentIds.insert(id);
+
+        const QJsonObject* previousConfig = previousApplications.value(id, nullptr);
+        if (!previousConfig) {
+            delta.addedApplications.append(appConfig);
+            continue;
+        }
+
+        bool replace = false;
+        for (const QString& key : APPLICATION_METADATA_KEYS) {
+            if (previousConfig->value(key) != appConfig.value(key)) {
+                replace = true;
+                break;
+            }
+        }
+        for (auto it = previousConfig->constBegin(); !replace && it != previousConfig->constEnd(); ++it) {
+            replace = !appConfig.contains(it.key());
+        }
+
+        if (replace) {
+            delta.removedApplications.append(id);
+            delta.addedApplications.append(appConfig);
+            continue;
+        }
+
+        QJsonObject changes;
+        for (auto it = appConfig.constBegin(); it != appConfig.constEnd(); ++it) {
+            if (previousConfig->value(it.key()) != it.value()) {
+                changes.insert(it.key(), it.value());
+            }
+        }
+        if (!changes.isEmpty()) {
+            changes["id"] = id;
+            delta.changedApplications.append(changes);
+        }
+    }
+
+    for (auto it = previousApplications.constBegin(); it != previousApplications.constEnd(); ++it) {
+        if (!currentIds.contains(it.key())) {
+            delta.removedApplications.append(it.key());
+        }
+    }
+
+    return delta;
+}
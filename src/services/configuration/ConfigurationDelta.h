@@ -0,0 +1,37 @@
+#ifndef SERVICES_CONFIGURATION_CONFIGURATIONDELTA_H
+#define SERVICES_CONFIGURATION_CONFIGURATIONDELTA_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QStringList>
+
+namespace Services::Configuration
+{
+class DeviceConfiguration;
+
+/**
+ * Structural difference between two device configurations, per application id and per
+ * system configuration key. Changed applications only carry the fields whose value changed,
+ * so they can be applied to the existing application objects.
+ */
+struct ConfigurationDelta
+{
+    QJsonObject changedSystemKeys;
+    QStringList removedSystemKeys;
+
+    QList<QJsonObject> addedApplications;
+    QList<QJsonObject> changedApplications; // "id" plus the changed fields only
+    QStringList removedApplications;
+
+    bool isEmpty() const;
+
+    /**
+     * Compare two configurations. An application whose metadata (type, name, order,
+     * watchface) changed, or that lost a field, is reported as removed and added again,
+     * since that cannot be applied to the existing object.
+     */
+    static ConfigurationDelta compute(const DeviceConfiguration& previous, const DeviceConfiguration& current);
+};
+} // namespace Services::Configuration
+
+#endif // SERVICES_CONFIGURATION_CONFIGURATIONDELTA_H
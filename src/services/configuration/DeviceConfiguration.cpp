@@ -4,6 +4,7 @@
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QSaveFile>
 #include <algorithm>
 
 namespace Services::Configuration
@@ -91,7 +92,7 @@ bool DeviceConfiguration::isValid() const
     return !version.isEmpty(); 
 }
 
-void DeviceConfiguration::saveToFile(const QString& directory) const
+bool DeviceConfiguration::saveToFile(const QString& directory) const
 {
     QString filePath = getConfigurationFilePath(directory);
 
@@ -101,18 +102,27 @@ void DeviceConfiguration::saveToFile(const QString& directory) const
         dir.mkpath(directory);
     }
 
-    QJsonDocument doc(toJson());
+    // Stamp the file with the cache format, so a file written by another version is never misread
+    QJsonObject cache;
+    cache["cache-version"] = CACHE_VERSION;
+    cache["saved-at"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    cache["configuration"] = toJson();
 
-    QFile file(filePath);
+    // Written to a temporary file and renamed on commit, a power cut never leaves a truncated file
+    QSaveFile file(filePath);
     if (!file.open(QIODevice::WriteOnly)) {
         qWarning() << "Failed to save configuration to" << filePath;
-        return;
+        return false;
     }
 
-    file.write(doc.toJson(QJsonDocument::Indented));
-    file.close();
+    file.write(QJsonDocument(cache).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "Failed to save configuration to" << filePath << ":" << file.errorString();
+        return false;
+    }
 
     qDebug() << "Configuration saved to" << filePath;
+    return true;
 }
 
 DeviceConfiguration DeviceConfiguration::loadFromFile(const QString& directory)
@@ -134,6 +144,12 @@ DeviceConfiguration DeviceConfiguration::loadFromFile(const QString& directory)
         return DeviceConfiguration();
     }
 
+    const int cacheVersion = doc.object()["cache-version"].toInt();
+    if (cacheVersion != CACHE_VERSION) {
+        qWarning() << "Ignoring configuration file" << filePath << "with cache version" << cacheVersion << ", expected" << CACHE_VERSION;
+        return DeviceConfiguration();
+    }
+
     DeviceConfiguration config = fromJson(doc.object());
     qDebug() << "Configuration loaded from" << filePath << "with" << config.applicationCount() << "applications";
 
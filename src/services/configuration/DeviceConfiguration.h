@@ -37,8 +37,9 @@ class DeviceConfiguration
     static DeviceConfiguration fromJson(const QJsonObject& json);
     bool isValid() const;
 
-    // Local persistence (configuration.json file)
-    void saveToFile(const QString& directory) const;
+    // Local persistence (configuration.json file), bumped when the file layout changes
+    static constexpr int CACHE_VERSION = 1;
+    bool saveToFile(const QString& directory) const;
     static DeviceConfiguration loadFromFile(const QString& directory);
     static QString getConfigurationFilePath(const QString& directory);
 
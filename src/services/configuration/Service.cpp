@@ -1,12 +1,18 @@
 #include "Service.h"
 #include "applications/common/Application.h"
 #include "applications/common/Configuration.h"
+#include "services/Initializer.h"
 #include "services/websocket/Service.h"
+#include "tracing/BootTrace.h"
 #include <QDebug>
 #include <QJsonObject>
+#include <QLoggingCategory>
 
 using namespace Services::Configuration;
 
+// Enable with QT_LOGGING_RULES="bee.configuration.payload.debug=true"
+Q_LOGGING_CATEGORY(lcConfigurationPayload, "bee.configuration.payload", QtInfoMsg)
+
 #ifdef PLATFORM_IS_TARGET
 const QString CONFIGURATION_PATH = QStringLiteral("/usr/share/bee/configuration");
 #else
@@ -21,6 +27,7 @@ Service::Service(Services::WebSocket::Service& webSocket, QObject* parent)
       m_startupTimeoutTimer(this),
       m_syncing(false),
       m_startupCheckInProgress(false),
+      m_loadedFromCache(false),
       m_currentConfig(nullptr)
 {
     // Subscribe to config change notifications
@@ -42,7 +49,24 @@ Service::Service(Services::WebSocket::Service& webSocket, QObject* parent)
         }
     });
 
-    performStartupCheck();
+}
+
+void Service::addInitializationSteps(Services::Initializer& initializer)
+{
+    initializer.addStep(
+        INITIALIZATION_STEP,
+        {},
+        [this]() {
+            m_localConfig = DeviceConfiguration::loadFromFile(CONFIGURATION_PATH);
+        },
+        [this]() {
+            // The last good configuration lets the UI come up right away, the backend configuration
+            // is applied as a delta once it arrives (requested on connect).
+            m_loadedFromCache = applyLocalConfiguration();
+            if (!m_loadedFromCache) {
+                performStartupCheck();
+            }
+        });
 }
 
 DeviceConfiguration* Service::getCurrentConfiguration()
@@ -58,7 +82,8 @@ void Service::triggerConfigurationChanged()
 
 void Service::onConfigurationReceived(const QJsonObject& configJson)
 {
-    qInfo() << "Received configuration JSON:" << QString::fromUtf8(QJsonDocument(configJson).toJson(QJsonDocument::Compact));
+    qInfo() << "Received configuration";
+    qCDebug(lcConfigurationPayload).noquote() << "Configuration payload:" << Services::WebSocket::Service::formatPayload(configJson);
     if (configJson.isEmpty()) {
         qWarning() << "Received empty configuration JSON";
         return;
@@ -72,10 +97,28 @@ void Service::onConfigurationReceived(const QJsonObject& configJson)
     setSyncing(true); // Indicate we are processing a new config
 
     DeviceConfiguration config = DeviceConfiguration::fromJson(configJson);
+
+    // Once applications exist, only hand out what changed instead of a full reload
+    const bool applyAsDelta = !startupCheckInProgress() && m_currentConfig && m_currentConfig->isValid();
+    ConfigurationDelta delta;
+    if (applyAsDelta) {
+        delta = ConfigurationDelta::compute(*m_currentConfig, config);
+    }
+
     updateCurrentConfig(config);
-    //config.saveToFile(CONFIGURATION_PATH); // Cache locally
+    if (!applyAsDelta || !delta.isEmpty()) {
+        config.saveToFile(CONFIGURATION_PATH); // Cache locally
+    }
     setConfigVersion(config.version);
-    if (!startupCheckInProgress()) {
+    if (applyAsDelta) {
+        if (delta.isEmpty()) {
+            qInfo() << "Received configuration is unchanged";
+        }
+        else {
+            emit configurationUpdated(delta);
+        }
+    }
+    else if (!startupCheckInProgress()) {
         emit configurationChanged();
     }
 
@@ -94,6 +137,7 @@ void Service::performStartupCheck()
 
     setSyncing(true); // Indicate we are trying to sync
     setStartupCheckInProgress(true);
+    Tracing::BootTrace::beginAsync("Configuration startup check");
 
     m_startupTimeoutTimer.setSingleShot(true);
     m_startupTimeoutTimer.setInterval(STARTUP_CHECK_TIMEOUT_MS);
@@ -142,10 +186,10 @@ void Service::completeStartupCheck()
     m_startupTimeoutTimer.stop();
     disconnect(m_startupConnectionWatcher);
     setStartupCheckInProgress(false);
+    Tracing::BootTrace::endAsync("Configuration startup check");
     setSyncing(false);
 
     if (!m_currentConfig || !m_currentConfig->isValid()) {
-        //loadLocalConfiguration();
         qInfo() << "No valid configuration loaded during startup check";
     }
 
@@ -153,17 +197,20 @@ void Service::completeStartupCheck()
     qInfo() << "Startup check complete. Waiting for push updates.";
 }
 
-void Service::loadLocalConfiguration()
+bool Service::applyLocalConfiguration()
 {
-    DeviceConfiguration config = DeviceConfiguration::loadFromFile(CONFIGURATION_PATH);
+    DeviceConfiguration config = m_localConfig;
+    m_localConfig = DeviceConfiguration();
 
     if (config.isValid() && config.hasApplications()) {
         qInfo() << "Loaded local configuration, version:" << config.version;
         updateCurrentConfig(config);
         setConfigVersion(config.version);
+        return true;
     }
     else {
         qInfo() << "No valid local configuration found";
+        return false;
     }
 }
 
@@ -195,6 +242,11 @@ bool Service::startupCheckInProgress() const
     return m_startupCheckInProgress;
 }
 
+bool Service::loadedFromCache() const
+{
+    return m_loadedFromCache;
+}
+
 void Service::setSyncing(bool syncing)
 {
     if (m_syncing != syncing) {
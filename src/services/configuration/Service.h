@@ -6,8 +6,14 @@
 #include <QObject>
 #include <QTimer>
 
+#include "ConfigurationDelta.h"
 #include "DeviceConfiguration.h"
 
+namespace Services
+{
+class Initializer;
+}
+
 namespace Services::WebSocket
 {
 class Service;
@@ -22,10 +28,19 @@ class Service : public QObject
     Q_PROPERTY(QDateTime lastSyncTime READ lastSyncTime NOTIFY lastSyncTimeChanged)
     Q_PROPERTY(QString configVersion READ configVersion NOTIFY configVersionChanged)
     Q_PROPERTY(bool startupCheckInProgress READ startupCheckInProgress NOTIFY startupCheckInProgressChanged)
+    Q_PROPERTY(bool loadedFromCache READ loadedFromCache CONSTANT)
 
   public:
+    static constexpr const char* INITIALIZATION_STEP = "Configuration cache";
+
     explicit Service(Services::WebSocket::Service& webSocket, QObject* parent = nullptr);
 
+    /**
+     * Reads the cached configuration on a worker thread. Until the step is ready there is no
+     * current configuration and no startup check.
+     */
+    void addInitializationSteps(Services::Initializer& initializer);
+
     DeviceConfiguration* getCurrentConfiguration();
 
     // Trigger signals
@@ -36,9 +51,11 @@ class Service : public QObject
     QDateTime lastSyncTime() const;
     QString configVersion() const;
     bool startupCheckInProgress() const;
+    bool loadedFromCache() const;
 
   signals:
     void configurationChanged();
+    void configurationUpdated(const Services::Configuration::ConfigurationDelta& delta);
     void syncingChanged();
     void lastSyncTimeChanged();
     void configVersionChanged();
@@ -47,7 +64,7 @@ class Service : public QObject
   private:
     void performStartupCheck();
     void completeStartupCheck();
-    void loadLocalConfiguration();
+    bool applyLocalConfiguration();
     void updateCurrentConfig(const DeviceConfiguration& config);
 
     void setSyncing(bool syncing);
@@ -63,9 +80,11 @@ class Service : public QObject
 
     bool m_syncing;
     bool m_startupCheckInProgress;
+    bool m_loadedFromCache;
     QString m_configVersion;
     QDateTime m_lastSyncTime;
     DeviceConfiguration* m_currentConfig;
+    DeviceConfiguration m_localConfig; // Read by the initialization step, then applied
 };
 } // namespace Services::Configuration
 
@@ -1,23 +1,141 @@
 #include "Service.h"
+#include <QDateTime>
 #include <QDebug>
+#include <QMetaMethod>
 #include <cassert>
+#include <limits>
 using namespace Services::DateTime;
 
+constexpr qint64 TICK_INTERVAL_MS = 1000;
+constexpr qint64 TICK_MARGIN_MS = 2; // Fire just after the boundary, so reads land in the new second
+constexpr qint64 SECONDS_IN_A_DAY = 24 * 60 * 60;
+
 Service::Service(QObject* parent)
     : QObject(parent),
-      m_timeZone(QTimeZone("Europe/Amsterdam"))
+      m_timeZone(QTimeZone("Europe/Amsterdam")),
+      m_tickTimer(this)
 {
     assert(m_timeZone.isValid()); // Time zones not available on system (install tzdata).
+
+    // Rescheduled on every tick, so the tick follows the wall clock when it is adjusted
+    m_tickTimer.setSingleShot(true);
+    m_tickTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_tickTimer, &QTimer::timeout, this, &Service::onTick);
 }
 
 QString Service::localTime() const
 {
-    QDateTime now = QDateTime::currentDateTimeUtc().toTimeZone(m_timeZone);
-    return now.toString("HH:mm:ss");
+    refresh(QDateTime::currentMSecsSinceEpoch());
+    return QString::asprintf("%02d:%02d:%02d", m_hours, m_minutes, m_seconds);
 }
 
 QString Service::utcTime() const
 {
-    QDateTime now = QDateTime::currentDateTimeUtc();
-    return now.toString("HH:mm:ss");
+    refresh(QDateTime::currentMSecsSinceEpoch());
+    const qint64 secondOfDay = m_cachedSecond % SECONDS_IN_A_DAY;
+    return QString::asprintf("%02d:%02d:%02d", int(secondOfDay / 3600), int(secondOfDay / 60 % 60), int(secondOfDay % 60));
+}
+
+int Service::hours() const
+{
+    refresh(QDateTime::currentMSecsSinceEpoch());
+    return m_hours;
+}
+
+int Service::minutes() const
+{
+    refresh(QDateTime::currentMSecsSinceEpoch());
+    return m_minutes;
+}
+
+int Service::seconds() const
+{
+    refresh(QDateTime::currentMSecsSinceEpoch());
+    return m_seconds;
+}
+
+qreal Service::fractionalSeconds() const
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    refresh(now);
+    return m_seconds + (now % TICK_INTERVAL_MS) / qreal(TICK_INTERVAL_MS);
+}
+
+bool Service::ticking() const
+{
+    return m_tickTimer.isActive();
+}
+
+void Service::connectNotify(const QMetaMethod& signal)
+{
+    if (signal == QMetaMethod::fromSignal(&Service::tick) || signal == QMetaMethod::fromSignal(&Service::timeChanged)) {
+        QMetaObject::invokeMethod(this, &Service::updateTicking, Qt::QueuedConnection);
+    }
+}
+
+void Service::disconnectNotify(const QMetaMethod& signal)
+{
+    // An invalid method means all signals were disconnected at once
+    if (!signal.isValid() || signal == QMetaMethod::fromSignal(&Service::tick) || signal == QMetaMethod::fromSignal(&Service::timeChanged)) {
+        QMetaObject::invokeMethod(this, &Service::updateTicking, Qt::QueuedConnection);
+    }
+}
+
+// Deferred from (dis)connectNotify, where the connection is not necessarily (un)registered yet
+void Service::updateTicking()
+{
+    const bool subscribed = isSignalConnected(QMetaMethod::fromSignal(&Service::tick)) ||
+                            isSignalConnected(QMetaMethod::fromSignal(&Service::timeChanged));
+    if (subscribed == m_tickTimer.isActive()) {
+        return;
+    }
+
+    if (subscribed) {
+        scheduleTick();
+    }
+    else {
+        m_tickTimer.stop();
+    }
+
+    qDebug() << "Second tick" << (subscribed ? "started" : "stopped");
+    emit tickingChanged();
+}
+
+void Service::scheduleTick()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    m_tickTimer.start(static_cast<int>(TICK_INTERVAL_MS - now % TICK_INTERVAL_MS + TICK_MARGIN_MS));
+}
+
+void Service::onTick()
+{
+    scheduleTick();
+    refresh(QDateTime::currentMSecsSinceEpoch());
+    emit tick();
+    emit timeChanged();
+}
+
+void Service::refresh(qint64 nowMs) const
+{
+    const qint64 second = nowMs / TICK_INTERVAL_MS;
+    if (second == m_cachedSecond) {
+        return;
+    }
+    m_cachedSecond = second;
+
+    // Converting to the time zone is expensive, the offset only changes at DST transitions
+    // (or when the wall clock is set back before the cached range).
+    if (nowMs < m_utcOffsetValidFromMs || nowMs >= m_utcOffsetValidUntilMs) {
+        const QDateTime utc = QDateTime::fromMSecsSinceEpoch(nowMs, QTimeZone(QTimeZone::UTC));
+        const QTimeZone::OffsetData next = m_timeZone.nextTransition(utc);
+        m_utcOffsetSeconds = m_timeZone.offsetFromUtc(utc);
+        m_utcOffsetValidFromMs = nowMs;
+        m_utcOffsetValidUntilMs = next.atUtc.isValid() ? next.atUtc.toMSecsSinceEpoch() : std::numeric_limits<qint64>::max();
+        qDebug() << "UTC offset" << m_utcOffsetSeconds << "s until" << next.atUtc;
+    }
+
+    const qint64 secondOfDay = (second + m_utcOffsetSeconds) % SECONDS_IN_A_DAY;
+    m_hours = static_cast<int>(secondOfDay / 3600);
+    m_minutes = static_cast<int>(secondOfDay / 60 % 60);
+    m_seconds = static_cast<int>(secondOfDay % 60);
 }
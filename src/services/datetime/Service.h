@@ -3,26 +3,74 @@
 
 #include <QObject>
 #include <QTimeZone>
+#include <QTimer>
+
+class TestDateTimeService;
 
 namespace Services::DateTime
 {
+/**
+ * Wall-clock time and the one second tick shared by everything that shows time.
+ * The tick is aligned to the second boundary and only runs while something is
+ * connected to tick() or timeChanged(), so hidden applications cost no wakeups.
+ * Local time fields are cached per second, the UTC offset until the next DST transition.
+ */
 class Service : public QObject
 {
     Q_OBJECT
     Q_PROPERTY(QString localTime READ localTime NOTIFY timeChanged)
     Q_PROPERTY(QString utcTime READ utcTime NOTIFY timeChanged)
+    Q_PROPERTY(int hours READ hours NOTIFY timeChanged)
+    Q_PROPERTY(int minutes READ minutes NOTIFY timeChanged)
+    Q_PROPERTY(int seconds READ seconds NOTIFY timeChanged)
+    Q_PROPERTY(qreal fractionalSeconds READ fractionalSeconds NOTIFY timeChanged)
+    Q_PROPERTY(bool ticking READ ticking NOTIFY tickingChanged)
 
   public:
     Service(QObject* parent = nullptr);
 
     QString localTime() const;
     QString utcTime() const;
+    int hours() const;
+    int minutes() const;
+    int seconds() const;
+
+    /**
+     * Seconds including the milliseconds of the current moment, for sweep hands that are
+     * animated in between ticks.
+     */
+    qreal fractionalSeconds() const;
+
+    bool ticking() const;
 
   signals:
+    void tick();
     void timeChanged();
+    void tickingChanged();
+
+  protected:
+    void connectNotify(const QMetaMethod& signal) override;
+    void disconnectNotify(const QMetaMethod& signal) override;
 
   private:
+    friend class ::TestDateTimeService; // Drives refresh() with chosen instants
+
+    void updateTicking();
+    void scheduleTick();
+    void onTick();
+    void refresh(qint64 nowMs) const;
+
     QTimeZone m_timeZone;
+    QTimer m_tickTimer;
+
+    // Cache of the current second, filled on demand by refresh()
+    mutable qint64 m_cachedSecond = -1; // Seconds since epoch
+    mutable int m_hours = 0;
+    mutable int m_minutes = 0;
+    mutable int m_seconds = 0;
+    mutable int m_utcOffsetSeconds = 0;
+    mutable qint64 m_utcOffsetValidFromMs = 0;
+    mutable qint64 m_utcOffsetValidUntilMs = 0; // Next DST transition
 };
 } // namespace Services::DateTime
 
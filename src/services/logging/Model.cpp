@@ -0,0 +1,173 @@
+#include "Model.h"
+#include <QDateTime>
+#include <algorithm>
+
+using namespace Services::Logging;
+
+constexpr int REFRESH_INTERVAL_MS = 250; // Batches bursts of log entries into one model update
+
+Model::Model(const RingBuffer& buffer, QObject* parent)
+    : QAbstractListModel(parent),
+      m_buffer(buffer),
+      m_scanned(0),
+      m_minimumLevel(Level::Debug)
+{
+    m_refreshTimer.setInterval(REFRESH_INTERVAL_MS);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &Model::refresh);
+}
+
+int Model::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent)
+    return m_rows.size();
+}
+
+QVariant Model::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size())
+        return QVariant();
+
+    Entry entry;
+    if (!m_buffer.read(m_rows.at(index.row()), entry)) {
+        return QVariant(); // Overwritten since the last refresh
+    }
+
+    switch (role) {
+    case TimestampRole:
+        return QDateTime::fromMSecsSinceEpoch(entry.timestampMs);
+    case LevelRole:
+        return static_cast<int>(entry.level);
+    case CategoryRole:
+        return entry.categoryString();
+    case MessageRole:
+        return entry.messageString();
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> Model::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[TimestampRole] = "timestamp";
+    roles[LevelRole] = "level";
+    roles[CategoryRole] = "category";
+    roles[MessageRole] = "message";
+    return roles;
+}
+
+Level Model::minimumLevel() const
+{
+    return m_minimumLevel;
+}
+
+void Model::setMinimumLevel(Level minimumLevel)
+{
+    if (m_minimumLevel == minimumLevel) {
+        return;
+    }
+
+    m_minimumLevel = minimumLevel;
+    rebuild();
+    emit filterChanged();
+}
+
+QString Model::categoryFilter() const
+{
+    return m_categoryFilter;
+}
+
+void Model::setCategoryFilter(const QString& categoryFilter)
+{
+    if (m_categoryFilter == categoryFilter) {
+        return;
+    }
+
+    m_categoryFilter = categoryFilter;
+    rebuild();
+    emit filterChanged();
+}
+
+bool Model::live() const
+{
+    return m_refreshTimer.isActive();
+}
+
+void Model::setLive(bool live)
+{
+    if (this->live() == live) {
+        return;
+    }
+
+    if (live) {
+        refresh();
+        m_refreshTimer.start();
+    }
+    else {
+        m_refreshTimer.stop();
+    }
+    emit liveChanged();
+}
+
+void Model::refresh()
+{
+    const int previousCount = m_rows.size();
+
+    // Drop rows whose entries have been overwritten
+    const quint64 tail = m_buffer.tail();
+    int overwritten = 0;
+    while (overwritten < m_rows.size() && m_rows.at(overwritten) < tail) {
+        ++overwritten;
+    }
+    if (overwritten > 0) {
+        beginRemoveRows(QModelIndex(), 0, overwritten - 1);
+        m_rows.remove(0, overwritten);
+        endRemoveRows();
+    }
+
+    // Append new matching entries, stopping at one that is still being written
+    QList<quint64> added;
+    const quint64 head = m_buffer.head();
+    m_scanned = std::max(m_scanned, tail);
+    Entry entry;
+    while (m_scanned < head) {
+        if (!m_buffer.read(m_scanned, entry)) {
+            if (m_scanned >= m_buffer.tail()) {
+                break;
+            }
+        }
+        else if (matches(entry)) {
+            added.append(m_scanned);
+        }
+        ++m_scanned;
+    }
+
+    if (!added.isEmpty()) {
+        beginInsertRows(QModelIndex(), m_rows.size(), m_rows.size() + added.size() - 1);
+        m_rows.append(added);
+        endInsertRows();
+    }
+
+    if (m_rows.size() != previousCount) {
+        emit countChanged();
+    }
+}
+
+bool Model::matches(const Entry& entry) const
+{
+    if (entry.level < m_minimumLevel) {
+        return false;
+    }
+    return m_categoryFilter.isEmpty() || QLatin1StringView(entry.category, entry.categoryLength).contains(m_categoryFilter, Qt::CaseInsensitive);
+}
+
+void Model::rebuild()
+{
+    beginResetModel();
+    m_rows.clear();
+    m_scanned = 0;
+    endResetModel();
+
+    refresh();
+    emit countChanged();
+}
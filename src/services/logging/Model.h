@@ -0,0 +1,71 @@
+#ifndef SERVICES_LOGGING_MODEL_H
+#define SERVICES_LOGGING_MODEL_H
+
+#include "RingBuffer.h"
+#include "Types.h"
+#include <QAbstractListModel>
+#include <QList>
+#include <QTimer>
+
+namespace Services::Logging
+{
+/**
+ * View on the log ring buffer, filtered by level and category. Rows only hold sequence numbers,
+ * the texts are read from the ring buffer when a delegate asks for them.
+ */
+class Model : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(Services::Logging::Level minimumLevel READ minimumLevel WRITE setMinimumLevel NOTIFY filterChanged)
+    Q_PROPERTY(QString categoryFilter READ categoryFilter WRITE setCategoryFilter NOTIFY filterChanged)
+    Q_PROPERTY(bool live READ live WRITE setLive NOTIFY liveChanged)
+
+  public:
+    enum Roles
+    {
+        TimestampRole = Qt::UserRole + 1,
+        LevelRole,
+        CategoryRole,
+        MessageRole
+    };
+
+    explicit Model(const RingBuffer& buffer, QObject* parent = nullptr);
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Level minimumLevel() const;
+    void setMinimumLevel(Level minimumLevel);
+
+    // Substring of the category, empty for all categories
+    QString categoryFilter() const;
+    void setCategoryFilter(const QString& categoryFilter);
+
+    // Follows new entries while set, e.g. while the logging panel is shown
+    bool live() const;
+    void setLive(bool live);
+
+    Q_INVOKABLE void refresh();
+
+  signals:
+    void countChanged();
+    void filterChanged();
+    void liveChanged();
+
+  private:
+    bool matches(const Entry& entry) const;
+    void rebuild();
+
+    const RingBuffer& m_buffer;
+    QList<quint64> m_rows; // Sequence numbers of matching entries, oldest first
+    quint64 m_scanned;     // Next sequence number to check
+    Level m_minimumLevel;
+    QString m_categoryFilter;
+    QTimer m_refreshTimer;
+};
+} // namespace Services::Logging
+
+#endif // SERVICES_LOGGING_MODEL_H
@@ -0,0 +1,88 @@
+#include "RingBuffer.h"
+#include <QDateTime>
+#include <algorithm>
+#include <cstring>
+
+using namespace Services::Logging;
+
+QString Entry::categoryString() const
+{
+    return QString::fromLatin1(category, categoryLength);
+}
+
+QString Entry::messageString() const
+{
+    return QString::fromUtf16(message, messageLength);
+}
+
+RingBuffer::RingBuffer()
+    : m_head(0),
+      m_dropped(0)
+{
+    for (Slot& slot : m_slots) {
+        slot.state.store(0, std::memory_order_relaxed);
+    }
+}
+
+void RingBuffer::write(Level level, const char* category, const QString& message)
+{
+    const quint64 sequence = m_head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = m_slots[sequence % CAPACITY];
+
+    // Claim the slot, unless a writer of an earlier lap is still in it or this writer stalled
+    // long enough for a later lap to take it; two writers in one slot would tear the entry
+    const quint64 writing = sequence * 2 + 1;
+    quint64 state = slot.state.load(std::memory_order_relaxed);
+    if (state % 2 == 1 || state > writing || !slot.state.compare_exchange_strong(state, writing, std::memory_order_relaxed)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Entry& entry = slot.entry;
+    entry.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    entry.level = level;
+
+    const size_t categoryLength = category ? std::min(std::strlen(category), size_t(Entry::CATEGORY_LENGTH)) : 0;
+    if (categoryLength > 0) {
+        std::memcpy(entry.category, category, categoryLength);
+    }
+    entry.categoryLength = quint8(categoryLength);
+
+    const qsizetype messageLength = std::min(message.size(), qsizetype(Entry::MESSAGE_LENGTH));
+    std::memcpy(entry.message, message.constData(), messageLength * sizeof(char16_t));
+    entry.messageLength = quint8(messageLength);
+
+    slot.state.store((sequence + 1) * 2, std::memory_order_release);
+}
+
+bool RingBuffer::read(quint64 sequence, Entry& entry) const
+{
+    const Slot& slot = m_slots[sequence % CAPACITY];
+    const quint64 expected = (sequence + 1) * 2;
+
+    if (slot.state.load(std::memory_order_acquire) != expected) {
+        return false;
+    }
+
+    std::memcpy(&entry, &slot.entry, sizeof(Entry));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.state.load(std::memory_order_relaxed) == expected;
+}
+
+quint64 RingBuffer::head() const
+{
+    return m_head.load(std::memory_order_acquire);
+}
+
+quint64 RingBuffer::tail() const
+{
+    const quint64 head = this->head();
+    return head > quint64(CAPACITY) ? head - CAPACITY : 0;
+}
+
+quint64 RingBuffer::dropped() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,77 @@
+#ifndef SERVICES_LOGGING_RINGBUFFER_H
+#define SERVICES_LOGGING_RINGBUFFER_H
+
+#include "Types.h"
+#include <QString>
+#include <array>
+#include <atomic>
+
+class TestRingBuffer;
+
+namespace Services::Logging
+{
+/**
+ * A log entry, formatted into fixed-size storage. Longer categories and messages are truncated.
+ */
+struct Entry
+{
+    static constexpr int CATEGORY_LENGTH = 32;
+    static constexpr int MESSAGE_LENGTH = 200;
+
+    qint64 timestampMs;
+    Level level;
+    quint8 categoryLength;
+    quint8 messageLength;
+    char category[CATEGORY_LENGTH];
+    char16_t message[MESSAGE_LENGTH];
+
+    QString categoryString() const;
+    QString messageString() const;
+};
+
+/**
+ * Fixed-size, lock-free ring buffer of the latest log entries.
+ * Any thread can write without allocating or locking, the oldest entries are overwritten.
+ * Every entry has a sequence number; readers copy an entry and check afterwards that
+ * it was not overwritten in the meantime (seqlock). A writer that laps one still writing
+ * the same slot drops its entry instead of writing over it.
+ */
+class RingBuffer
+{
+  public:
+    static constexpr int CAPACITY = 1024;
+
+    RingBuffer();
+
+    void write(Level level, const char* category, const QString& message);
+
+    /**
+     * Copies the entry with the given sequence number, false when it is overwritten or not yet written.
+     */
+    bool read(quint64 sequence, Entry& entry) const;
+
+    // Sequence number the next entry is written with
+    quint64 head() const;
+
+    // Oldest sequence number that can still be read
+    quint64 tail() const;
+
+    // Entries dropped because their slot was still being written by an earlier lap
+    quint64 dropped() const;
+
+  private:
+    friend class ::TestRingBuffer; // Stalls a writer in the middle of an entry
+
+    struct Slot
+    {
+        std::atomic<quint64> state; // 0 when empty, odd while being written, (sequence + 1) * 2 once complete
+        Entry entry;
+    };
+
+    std::atomic<quint64> m_head;
+    std::atomic<quint64> m_dropped;
+    std::array<Slot, CAPACITY> m_slots;
+};
+} // namespace Services::Logging
+
+#endif // SERVICES_LOGGING_RINGBUFFER_H
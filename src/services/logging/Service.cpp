@@ -0,0 +1,222 @@
+#include "Service.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSettings>
+#include <QtConcurrent>
+#include <algorithm>
+#include <atomic>
+
+using namespace Services::Logging;
+
+#ifdef PLATFORM_IS_TARGET
+const QString LOG_PATH = QStringLiteral("/usr/share/bee/logs/clock-app.log");
+#else
+const QString LOG_PATH = QStringLiteral("/workdir/build/bee/logs/clock-app.log");
+#endif
+
+const QString PROPERTIES_GROUP_NAME = QStringLiteral("logging");
+const QString PROPERTY_CAPTURE_LEVEL_KEY = QStringLiteral("capture-level");
+const Level PROPERTY_CAPTURE_LEVEL_DEFAULT = Level::Debug;
+const QString PROPERTY_FILE_LOGGING_KEY = QStringLiteral("file-logging");
+const bool PROPERTY_FILE_LOGGING_DEFAULT = false;
+
+constexpr int FLUSH_INTERVAL_MS = 5000;            // Batches file writes, the storage is flash
+constexpr qint64 MAX_LOG_FILE_BYTES = 1024 * 1024; // Size at which the log file is rotated
+constexpr int LOG_FILE_COUNT = 3;                  // Rotated files that are kept next to the current one
+
+namespace
+{
+std::atomic<int> s_captureLevel(static_cast<int>(PROPERTY_CAPTURE_LEVEL_DEFAULT));
+QtMessageHandler s_previousHandler = nullptr;
+} // namespace
+
+Service::Service(QObject* parent)
+    : QObject(parent),
+      m_model(buffer(), this),
+      m_flushed(0),
+      m_flushing(false),
+      m_fileLogging(false)
+{
+    // A single thread keeps the file writes in order
+    m_pool.setMaxThreadCount(1);
+    m_pool.setThreadPriority(QThread::LowPriority);
+
+    m_flushTimer.setInterval(FLUSH_INTERVAL_MS);
+    connect(&m_flushTimer, &QTimer::timeout, this, &Service::flush);
+
+    loadProperties();
+}
+
+Service::~Service()
+{
+    if (m_fileLogging) {
+        m_pool.waitForDone();
+        writeEntries(m_flushed, buffer().head());
+    }
+}
+
+void Service::install()
+{
+    buffer();
+    s_previousHandler = qInstallMessageHandler(&Service::messageHandler);
+}
+
+RingBuffer& Service::buffer()
+{
+    static RingBuffer s_buffer;
+    return s_buffer;
+}
+
+Model* Service::model()
+{
+    return &m_model;
+}
+
+Level Service::captureLevel() const
+{
+    return static_cast<Level>(s_captureLevel.load(std::memory_order_relaxed));
+}
+
+void Service::setCaptureLevel(Level captureLevel)
+{
+    if (this->captureLevel() == captureLevel) {
+        return;
+    }
+
+    s_captureLevel.store(static_cast<int>(captureLevel), std::memory_order_relaxed);
+    saveProperty(PROPERTY_CAPTURE_LEVEL_KEY, static_cast<int>(captureLevel));
+    emit captureLevelChanged();
+}
+
+bool Service::fileLogging() const
+{
+    return m_fileLogging;
+}
+
+void Service::setFileLogging(bool fileLogging)
+{
+    if (m_fileLogging == fileLogging) {
+        return;
+    }
+
+    m_fileLogging = fileLogging;
+    saveProperty(PROPERTY_FILE_LOGGING_KEY, fileLogging);
+
+    if (fileLogging) {
+        // Everything still in memory goes to the file as well, including the boot
+        m_flushed = std::max(m_flushed, buffer().tail());
+        flush();
+        m_flushTimer.start();
+        qInfo() << "File logging enabled, writing to" << LOG_PATH;
+    }
+    else {
+        m_flushTimer.stop();
+        qInfo() << "File logging disabled";
+    }
+
+    emit fileLoggingChanged();
+}
+
+void Service::messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    // Called from any thread: no locks and no allocations until the previous handler
+    const Level level = levelFromMsgType(type);
+    if (static_cast<int>(level) >= s_captureLevel.load(std::memory_order_relaxed)) {
+        buffer().write(level, context.category, message);
+    }
+
+    if (s_previousHandler) {
+        s_previousHandler(type, context, message);
+    }
+}
+
+quint64 Service::writeEntries(quint64 from, quint64 to)
+{
+    QFileInfo info(LOG_PATH);
+    QDir().mkpath(info.absolutePath());
+    if (info.exists() && info.size() > MAX_LOG_FILE_BYTES) {
+        rotate();
+    }
+
+    QFile file(LOG_PATH);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        return to; // Nothing sensible to retry, and logging the failure would only feed the buffer
+    }
+
+    const RingBuffer& ring = buffer();
+    Entry entry;
+    quint64 lost = 0;
+    quint64 sequence = from;
+    for (; sequence < to; ++sequence) {
+        if (!ring.read(sequence, entry)) {
+            if (sequence >= ring.tail()) {
+                break; // Still being written, picked up by the next flush
+            }
+            ++lost;
+            continue;
+        }
+
+        if (lost > 0) {
+            file.write(QStringLiteral("... %1 entries overwritten before they were written ...\n").arg(lost).toUtf8());
+            lost = 0;
+        }
+
+        const QString line = QStringLiteral("%1 %2 %3: %4\n")
+                                 .arg(QDateTime::fromMSecsSinceEpoch(entry.timestampMs).toString(Qt::ISODateWithMs),
+                                      levelToString(entry.level),
+                                      entry.categoryString(),
+                                      entry.messageString());
+        file.write(line.toUtf8());
+    }
+
+    return sequence;
+}
+
+void Service::rotate()
+{
+    QFile::remove(QStringLiteral("%1.%2").arg(LOG_PATH).arg(LOG_FILE_COUNT));
+    for (int i = LOG_FILE_COUNT - 1; i >= 1; --i) {
+        QFile::rename(QStringLiteral("%1.%2").arg(LOG_PATH).arg(i), QStringLiteral("%1.%2").arg(LOG_PATH).arg(i + 1));
+    }
+    QFile::rename(LOG_PATH, QStringLiteral("%1.1").arg(LOG_PATH));
+}
+
+void Service::loadProperties()
+{
+    QSettings settings;
+    settings.beginGroup(PROPERTIES_GROUP_NAME);
+    const Level captureLevel = static_cast<Level>(settings.value(PROPERTY_CAPTURE_LEVEL_KEY, static_cast<int>(PROPERTY_CAPTURE_LEVEL_DEFAULT)).toInt());
+    const bool fileLogging = settings.value(PROPERTY_FILE_LOGGING_KEY, PROPERTY_FILE_LOGGING_DEFAULT).toBool();
+    settings.endGroup();
+
+    s_captureLevel.store(static_cast<int>(captureLevel), std::memory_order_relaxed);
+    setFileLogging(fileLogging);
+}
+
+void Service::saveProperty(const QString& key, const QVariant& value)
+{
+    QSettings settings;
+    settings.beginGroup(PROPERTIES_GROUP_NAME);
+    settings.setValue(key, value);
+    settings.endGroup();
+}
+
+void Service::flush()
+{
+    const quint64 head = buffer().head();
+    if (m_flushing || m_flushed >= head) {
+        return;
+    }
+
+    m_flushing = true;
+    const quint64 from = std::max(m_flushed, buffer().tail());
+    m_flushed = head;
+
+    QtConcurrent::run(&m_pool, &Service::writeEntries, from, head).then(this, [this](quint64 next) {
+        m_flushed = next;
+        m_flushing = false;
+    });
+}
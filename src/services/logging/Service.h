@@ -0,0 +1,69 @@
+#ifndef SERVICES_LOGGING_SERVICE_H
+#define SERVICES_LOGGING_SERVICE_H
+
+#include "Model.h"
+#include "RingBuffer.h"
+#include "Types.h"
+#include <QObject>
+#include <QThreadPool>
+#include <QTimer>
+
+namespace Services::Logging
+{
+/**
+ * Service
+ *
+ * Keeps the latest log output of the application in memory, for the logging panel, and
+ * optionally flushes it to a rotating file in the background.
+ * The message handler is installed by install() at the very start of main(), so the entries
+ * written before the service exists are kept as well.
+ */
+class Service : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(Services::Logging::Model* model READ model CONSTANT)
+    Q_PROPERTY(Services::Logging::Level captureLevel READ captureLevel WRITE setCaptureLevel NOTIFY captureLevelChanged)
+    Q_PROPERTY(bool fileLogging READ fileLogging WRITE setFileLogging NOTIFY fileLoggingChanged)
+
+  public:
+    explicit Service(QObject* parent = nullptr);
+    ~Service() override;
+
+    /**
+     * Installs the message handler in front of the current one, which still receives every message.
+     */
+    static void install();
+    static RingBuffer& buffer();
+
+    Model* model();
+
+    // Entries below this level are not kept
+    Level captureLevel() const;
+    void setCaptureLevel(Level captureLevel);
+
+    bool fileLogging() const;
+    void setFileLogging(bool fileLogging);
+
+  signals:
+    void captureLevelChanged();
+    void fileLoggingChanged();
+
+  private:
+    static void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message);
+    static quint64 writeEntries(quint64 from, quint64 to);
+    static void rotate();
+
+    void loadProperties();
+    void saveProperty(const QString& key, const QVariant& value);
+    void flush();
+
+    Model m_model;
+    QThreadPool m_pool;
+    QTimer m_flushTimer;
+    quint64 m_flushed; // Next sequence number to write to the file
+    bool m_flushing;
+    bool m_fileLogging;
+};
+} // namespace Services::Logging
+
+#endif // SERVICES_LOGGING_SERVICE_H
@@ -0,0 +1,58 @@
+#ifndef SERVICES_LOGGING_TYPES_H
+#define SERVICES_LOGGING_TYPES_H
+
+#include <QObject>
+#include <QString>
+
+namespace Services::Logging
+{
+Q_NAMESPACE
+
+// Severity of a log entry, unlike QtMsgType ordered from least to most severe
+enum class Level
+{
+    Debug,
+    Info,
+    Warning,
+    Critical,
+    Fatal
+};
+Q_ENUM_NS(Level)
+
+inline Level levelFromMsgType(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return Level::Debug;
+    case QtInfoMsg:
+        return Level::Info;
+    case QtWarningMsg:
+        return Level::Warning;
+    case QtCriticalMsg:
+        return Level::Critical;
+    case QtFatalMsg:
+    default:
+        return Level::Fatal;
+    }
+}
+
+inline QString levelToString(Level level)
+{
+    switch (level) {
+    case Level::Debug:
+        return "debug";
+    case Level::Info:
+        return "info";
+    case Level::Warning:
+        return "warning";
+    case Level::Critical:
+        return "critical";
+    case Level::Fatal:
+        return "fatal";
+    default:
+        return "unknown";
+    }
+}
+} // namespace Services::Logging
+
+#endif // SERVICES_LOGGING_TYPES_H
@@ -0,0 +1,221 @@
+#include "DownloadQueue.h"
+#include "services/rest/Service.h"
+#include <QDebug>
+#include <QNetworkReply>
+#include <QSet>
+#include <QTimer>
+#include <algorithm>
+
+using namespace Services::Media;
+
+constexpr int DEFAULT_MAX_CONCURRENT_DOWNLOADS = 2;
+constexpr int MAX_DOWNLOAD_ATTEMPTS = 4;
+constexpr int RETRY_BASE_DELAY_MS = 2000;  // Doubled for every failed attempt
+constexpr int RETRY_MAX_DELAY_MS = 60000;  // 1 minute
+
+DownloadQueue::DownloadQueue(Services::Rest::Service& rest, const QString& directory, QObject* parent)
+    : QObject(parent),
+      m_rest(rest),
+      m_directory(directory),
+      m_maxConcurrentDownloads(DEFAULT_MAX_CONCURRENT_DOWNLOADS),
+      m_nextTransferId(0)
+{
+}
+
+int DownloadQueue::maxConcurrentDownloads() const
+{
+    return m_maxConcurrentDownloads;
+}
+
+void DownloadQueue::setMaxConcurrentDownloads(int maxConcurrentDownloads)
+{
+    m_maxConcurrentDownloads = qMax(1, maxConcurrentDownloads);
+    schedule();
+}
+
+void DownloadQueue::setPriorities(const QStringList& filenames)
+{
+    m_priorities = filenames;
+    sortQueue();
+}
+
+void DownloadQueue::replace(const QStringList& filenames)
+{
+    const QSet<QString> wanted(filenames.cbegin(), filenames.cend());
+
+    // Abort transfers of files that are no longer wanted
+    for (auto it = m_running.begin(); it != m_running.end();) {
+        if (wanted.contains(it.key())) {
+            ++it;
+            continue;
+        }
+
+        qDebug() << "Cancelling download of" << it.key();
+        QPointer<QNetworkReply> reply = it->reply;
+        it = m_running.erase(it);
+        if (reply) {
+            reply->abort();
+        }
+    }
+
+    for (auto it = m_waiting.begin(); it != m_waiting.end();) {
+        if (wanted.contains(it.key())) {
+            ++it;
+        }
+        else {
+            it = m_waiting.erase(it);
+        }
+    }
+
+    // Partial files of cancelled transfers, or of earlier runs, would never be resumed and only take space
+    const QStringList partialDownloads = Services::Rest::Service::partialDownloads(m_directory);
+    for (const QString& filename : partialDownloads) {
+        if (!wanted.contains(filename)) {
+            Services::Rest::Service::removePartialDownload(m_directory + "/" + filename);
+        }
+    }
+
+    m_queued.clear();
+    QSet<QString> queued;
+    for (const QString& filename : filenames) {
+        if (!m_running.contains(filename) && !m_waiting.contains(filename) && !queued.contains(filename)) {
+            queued.insert(filename);
+            m_queued.append(filename);
+        }
+    }
+
+    // A new file list is a fresh start for every file that is not being tried right now, a backend
+    // resending the list must not reset a failing transfer past MAX_DOWNLOAD_ATTEMPTS
+    for (auto it = m_attempts.begin(); it != m_attempts.end();) {
+        if (m_running.contains(it.key()) || m_waiting.contains(it.key())) {
+            ++it;
+        }
+        else {
+            it = m_attempts.erase(it);
+        }
+    }
+
+    sortQueue();
+    schedule();
+    checkIdle();
+}
+
+void DownloadQueue::cancelAll()
+{
+    replace(QStringList());
+}
+
+bool DownloadQueue::isIdle() const
+{
+    return pendingCount() == 0;
+}
+
+int DownloadQueue::pendingCount() const
+{
+    return m_queued.size() + m_running.size() + m_waiting.size();
+}
+
+void DownloadQueue::schedule()
+{
+    while (m_running.size() < m_maxConcurrentDownloads && !m_queued.isEmpty()) {
+        start(m_queued.takeFirst());
+    }
+}
+
+void DownloadQueue::start(const QString& filename)
+{
+    const quint64 id = ++m_nextTransferId;
+    const int attempt = ++m_attempts[filename];
+
+    qDebug() << "Downloading" << filename << "( attempt" << attempt << "of" << MAX_DOWNLOAD_ATTEMPTS << ")";
+
+    auto progress = [this, filename, id](qint64 bytesReceived, qint64 bytesTotal) {
+        if (m_running.value(filename).id == id) {
+            emit downloadProgress(filename, bytesReceived, bytesTotal);
+        }
+    };
+
+    // Register the transfer before starting it; the reply is filled in once it exists
+    m_running.insert(filename, Transfer{id, nullptr});
+    QNetworkReply* reply = m_rest.downloadToFile("media/" + filename, m_directory + "/" + filename, [this, filename, id](bool success, const QString& filePath, const QString& error) {
+        onTransferFinished(filename, id, success, filePath, error);
+    }, progress);
+
+    auto it = m_running.find(filename);
+    if (it != m_running.end() && it->id == id) {
+        it->reply = reply;
+    }
+}
+
+void DownloadQueue::onTransferFinished(const QString& filename, quint64 id, bool success, const QString& filePath, const QString& error)
+{
+    auto it = m_running.find(filename);
+    if (it == m_running.end() || it->id != id) {
+        return; // Cancelled or superseded
+    }
+    m_running.erase(it);
+
+    if (success) {
+        m_attempts.remove(filename);
+        emit downloadFinished(filename, filePath);
+    }
+    else if (m_attempts.value(filename) < MAX_DOWNLOAD_ATTEMPTS) {
+        qWarning() << "Download of" << filename << "failed:" << error << ", retrying";
+        retryLater(filename);
+    }
+    else {
+        qWarning() << "Download of" << filename << "failed after" << MAX_DOWNLOAD_ATTEMPTS << "attempts:" << error;
+        m_attempts.remove(filename);
+        emit downloadFailed(filename, error);
+    }
+
+    schedule();
+    checkIdle();
+}
+
+void DownloadQueue::retryLater(const QString& filename)
+{
+    const int attempt = m_attempts.value(filename);
+    const int delay = qMin(RETRY_MAX_DELAY_MS, RETRY_BASE_DELAY_MS << qMin(attempt - 1, 16));
+    const quint64 id = ++m_nextTransferId;
+    m_waiting.insert(filename, id);
+
+    QTimer::singleShot(delay, this, [this, filename, id]() {
+        auto it = m_waiting.find(filename);
+        if (it == m_waiting.end() || it.value() != id) {
+            return; // Cancelled while waiting
+        }
+        m_waiting.erase(it);
+
+        // Retries go ahead of the files with the same priority, so a failing file does not starve behind them.
+        // The stable sort keeps that order, prioritised files still come first.
+        m_queued.prepend(filename);
+        sortQueue();
+        schedule();
+    });
+}
+
+void DownloadQueue::sortQueue()
+{
+    if (m_queued.size() < 2 || m_priorities.isEmpty()) {
+        return;
+    }
+
+    QHash<QString, qsizetype> ranks;
+    ranks.reserve(m_priorities.size());
+    for (qsizetype i = m_priorities.size() - 1; i >= 0; --i) {
+        ranks.insert(m_priorities.at(i), i); // The first occurrence wins
+    }
+
+    const qsizetype unprioritised = m_priorities.size();
+    std::stable_sort(m_queued.begin(), m_queued.end(), [&ranks, unprioritised](const QString& a, const QString& b) {
+        return ranks.value(a, unprioritised) < ranks.value(b, unprioritised);
+    });
+}
+
+void DownloadQueue::checkIdle()
+{
+    if (isIdle()) {
+        emit idle();
+    }
+}
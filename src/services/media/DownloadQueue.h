@@ -0,0 +1,85 @@
+#ifndef SERVICES_MEDIA_DOWNLOADQUEUE_H
+#define SERVICES_MEDIA_DOWNLOADQUEUE_H
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+
+class QNetworkReply;
+
+namespace Services::Rest
+{
+class Service;
+}
+
+namespace Services::Media
+{
+/**
+ * DownloadQueue
+ *
+ * Downloads media files into a directory with a bounded number of concurrent transfers.
+ * Queued files are started in priority order and failed transfers are retried with an
+ * exponential backoff. Replacing the queue cancels transfers that are no longer wanted.
+ */
+class DownloadQueue : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit DownloadQueue(Services::Rest::Service& rest, const QString& directory, QObject* parent = nullptr);
+
+    int maxConcurrentDownloads() const;
+    void setMaxConcurrentDownloads(int maxConcurrentDownloads);
+
+    /**
+     * Files that should be downloaded before any other file, most important first.
+     */
+    void setPriorities(const QStringList& filenames);
+
+    /**
+     * Replace the set of files to download. Transfers of files that are still wanted keep
+     * running, all other queued, waiting or running transfers are cancelled and their
+     * partial files removed.
+     */
+    void replace(const QStringList& filenames);
+    void cancelAll();
+
+    bool isIdle() const;
+    int pendingCount() const;
+
+  signals:
+    void downloadFinished(const QString& filename, const QString& filePath);
+    void downloadFailed(const QString& filename, const QString& error);
+    void downloadProgress(const QString& filename, qint64 bytesReceived, qint64 bytesTotal);
+    void idle();
+
+  private:
+    struct Transfer
+    {
+        quint64 id = 0;
+        QPointer<QNetworkReply> reply;
+    };
+
+    void schedule();
+    void start(const QString& filename);
+    void onTransferFinished(const QString& filename, quint64 id, bool success, const QString& filePath, const QString& error);
+    void retryLater(const QString& filename);
+    void sortQueue();
+    void checkIdle();
+
+    Services::Rest::Service& m_rest;
+    QString m_directory;
+    int m_maxConcurrentDownloads;
+    quint64 m_nextTransferId;
+
+    QStringList m_priorities;
+    QStringList m_queued;
+    QHash<QString, Transfer> m_running;
+    QHash<QString, quint64> m_waiting; // Files waiting for a retry, with the id of the scheduled retry
+    QHash<QString, int> m_attempts;
+};
+} // namespace Services::Media
+
+#endif // SERVICES_MEDIA_DOWNLOADQUEUE_H
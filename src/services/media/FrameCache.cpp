@@ -0,0 +1,318 @@
+#include "FrameCache.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QImageReader>
+#include <QPainter>
+#include <QtConcurrent>
+
+using namespace Services::Media;
+
+constexpr int DEFAULT_FRAME_DELAY_MS = 100; // Used when a frame does not specify its own delay
+constexpr int PREFETCH_THREADS = 1;         // Leave the other cores to rendering
+constexpr int STATISTICS_INTERVAL_MS = 1000; // Coalesces counter updates, every lookup changes them
+
+FrameCache* FrameCache::s_instance = nullptr;
+
+FrameCache::FrameCache(qint64 budgetBytes, QObject* parent)
+    : QObject(parent),
+      m_nextPrefetchId(0),
+      m_budget(budgetBytes),
+      m_bytes(0),
+      m_hits(0),
+      m_misses(0),
+      m_useCounter(0)
+{
+    m_pool.setMaxThreadCount(PREFETCH_THREADS);
+    m_pool.setThreadPriority(QThread::LowPriority);
+
+    m_statisticsTimer.setSingleShot(true);
+    m_statisticsTimer.setInterval(STATISTICS_INTERVAL_MS);
+    connect(&m_statisticsTimer, &QTimer::timeout, this, &FrameCache::statisticsChanged);
+
+    s_instance = this;
+}
+
+FrameCache::~FrameCache()
+{
+    if (s_instance == this) {
+        s_instance = nullptr;
+    }
+}
+
+FrameCache* FrameCache::instance()
+{
+    return s_instance;
+}
+
+QSharedPointer<const Frames> FrameCache::frames(const QString& path, const QSize& size)
+{
+    if (path.isEmpty() || size.isEmpty()) {
+        return nullptr;
+    }
+
+    const QString key = cacheKey(path, size);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        it->lastUsed = ++m_useCounter;
+        ++m_hits;
+        notifyStatistics();
+        return it->frames;
+    }
+
+    if (m_failed.contains(key)) {
+        ++m_hits;
+        notifyStatistics();
+        return nullptr;
+    }
+
+    // Never decoded on the GUI thread, the caller shows a placeholder until framesReady()
+    ++m_misses;
+    notifyStatistics();
+    prefetch(path, size);
+    return nullptr;
+}
+
+void FrameCache::prefetch(const QString& path, const QSize& size)
+{
+    if (path.isEmpty() || size.isEmpty()) {
+        return;
+    }
+
+    const QString key = cacheKey(path, size);
+    if (m_entries.contains(key) || m_prefetches.contains(key) || m_failed.contains(key)) {
+        return;
+    }
+
+    const quint64 id = ++m_nextPrefetchId;
+    m_prefetches.insert(key, Prefetch{path, id});
+
+    QtConcurrent::run(&m_pool, &FrameCache::decode, path, size).then(this, [this, key, path, size, id](const QSharedPointer<const Frames>& frames) {
+        auto it = m_prefetches.find(key);
+        if (it != m_prefetches.end() && it->id != id) {
+            return; // Superseded by a newer prefetch, which reports instead
+        }
+
+        // Frames of an invalidated file are dropped, waiting images load the new file themselves
+        if (it != m_prefetches.end()) {
+            m_prefetches.erase(it);
+            if (frames) {
+                insert(key, path, frames);
+            }
+            else {
+                m_failed.insert(key, path);
+            }
+            notifyStatistics();
+        }
+        emit framesReady(path, size);
+    });
+}
+
+bool FrameCache::contains(const QString& path, const QSize& size) const
+{
+    const QString key = cacheKey(path, size);
+    return m_entries.contains(key) || m_failed.contains(key);
+}
+
+bool FrameCache::isPrefetching(const QString& path, const QSize& size) const
+{
+    return m_prefetches.contains(cacheKey(path, size));
+}
+
+void FrameCache::setRetainedPaths(const QStringList& paths)
+{
+    m_retainedPaths = QSet<QString>(paths.cbegin(), paths.cend());
+    evict(QString());
+    notifyStatistics();
+}
+
+void FrameCache::invalidate(const QString& path)
+{
+    m_prefetches.removeIf([&path](QHash<QString, Prefetch>::iterator it) {
+        return it->path == path;
+    });
+    m_failed.removeIf([&path](QHash<QString, QString>::iterator it) {
+        return it.value() == path;
+    });
+
+    bool changed = false;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->path == path) {
+            m_bytes -= it->frames->bytes;
+            it = m_entries.erase(it);
+            changed = true;
+        }
+        else {
+            ++it;
+        }
+    }
+
+    if (changed) {
+        notifyStatistics();
+    }
+}
+
+void FrameCache::clear()
+{
+    m_prefetches.clear();
+    m_failed.clear();
+    m_entries.clear();
+    m_bytes = 0;
+    notifyStatistics();
+}
+
+quint64 FrameCache::hits() const
+{
+    return m_hits;
+}
+
+quint64 FrameCache::misses() const
+{
+    return m_misses;
+}
+
+qint64 FrameCache::bytes() const
+{
+    return m_bytes;
+}
+
+qint64 FrameCache::budget() const
+{
+    return m_budget;
+}
+
+QSharedPointer<const Frames> FrameCache::decode(const QString& path, const QSize& size)
+{
+    QElapsedTimer lTimer;
+    lTimer.start();
+
+    auto frames = QSharedPointer<Frames>::create();
+
+    QImageReader reader(path);
+    while (reader.canRead()) {
+        QImage frame = reader.read();
+        if (frame.isNull()) {
+            break;
+        }
+
+        QImage masked = maskFrame(frame, size);
+        frames->bytes += masked.sizeInBytes();
+        frames->images.append(masked);
+
+        int delay = reader.nextImageDelay();
+        frames->delays.append(delay > 0 ? delay : DEFAULT_FRAME_DELAY_MS);
+
+        if (!reader.supportsAnimation()) {
+            break;
+        }
+    }
+
+    if (frames->images.isEmpty()) {
+        qWarning() << "Invalid movie source:" << path << reader.errorString();
+        return nullptr;
+    }
+
+    qDebug() << "Decoded" << frames->images.size() << "frames of" << path << "in" << lTimer.elapsed() << "ms";
+    return frames;
+}
+
+QString FrameCache::localPath(const QString& source)
+{
+    QString path = source;
+    if (path.startsWith("qrc:/")) {
+        path.replace(0, 4, ":");
+    }
+    return path;
+}
+
+QString FrameCache::cacheKey(const QString& path, const QSize& size)
+{
+    return QStringLiteral("%1@%2x%3").arg(path).arg(size.width()).arg(size.height());
+}
+
+QImage FrameCache::maskFrame(const QImage& frame, const QSize& size)
+{
+    // Scale the frame to fill the target size, keeping aspect ratio
+    QImage scaledFrame = frame.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+
+    QImage result(size, QImage::Format_ARGB32_Premultiplied);
+    result.fill(Qt::transparent);
+
+    QPainter painter(&result);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+
+    // Center the image if aspect ratio does not match
+    painter.drawImage(QPointF((size.width() - scaledFrame.width()) / 2.0,
+                              (size.height() - scaledFrame.height()) / 2.0),
+                      scaledFrame);
+
+    // Bake the circular mask into the alpha channel once, instead of clipping on every frame
+    painter.setCompositionMode(QPainter::CompositionMode_DestinationIn);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(Qt::black);
+    painter.drawEllipse(QRectF(QPointF(0, 0), QSizeF(size)));
+    painter.end();
+
+    return result;
+}
+
+void FrameCache::insert(const QString& key, const QString& path, const QSharedPointer<const Frames>& frames)
+{
+    if (!frames) {
+        return;
+    }
+
+    m_entries.insert(key, Entry{path, frames, ++m_useCounter});
+    m_bytes += frames->bytes;
+    evict(key);
+}
+
+void FrameCache::evict(const QString& keepKey)
+{
+    // Least recently used entries go first; retained media only when nothing else is left.
+    while (m_bytes > m_budget) {
+        QString victim;
+        bool victimRetained = true;
+        quint64 victimLastUsed = 0;
+
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+            if (it.key() == keepKey) {
+                continue;
+            }
+
+            bool retained = m_retainedPaths.contains(it->path);
+            bool better = victim.isEmpty() ||
+                          (victimRetained && !retained) ||
+                          (victimRetained == retained && it->lastUsed < victimLastUsed);
+            if (better) {
+                victim = it.key();
+                victimRetained = retained;
+                victimLastUsed = it->lastUsed;
+            }
+        }
+
+        if (victim.isEmpty()) {
+            return;
+        }
+
+        qDebug() << "Evicting decoded frames of" << m_entries.value(victim).path << "from frame cache";
+        removeEntry(victim);
+    }
+}
+
+void FrameCache::removeEntry(const QString& key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    m_bytes -= it->frames->bytes;
+    m_entries.erase(it);
+}
+
+void FrameCache::notifyStatistics()
+{
+    if (!m_statisticsTimer.isActive()) {
+        m_statisticsTimer.start();
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef SERVICES_MEDIA_FRAMECACHE_H
+#define SERVICES_MEDIA_FRAMECACHE_H
+
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QSize>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+
+namespace Services::Media
+{
+/**
+ * Decoded animation of a single media file, scaled and round-masked for one target size.
+ */
+struct Frames
+{
+    QList<QImage> images;
+    QList<int> delays;
+    qint64 bytes = 0;
+};
+
+/**
+ * Process-wide, memory budgeted LRU cache of decoded frames, keyed by media path and target size.
+ * Entries of retained media (backgrounds referenced by the current configuration) are only
+ * evicted once nothing else is left to evict. Files that cannot be decoded are remembered as
+ * well, until they are invalidated.
+ * The cache itself is only used from the GUI thread, frames are decoded on a worker and
+ * inserted once done.
+ */
+class FrameCache : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit FrameCache(qint64 budgetBytes, QObject* parent = nullptr);
+    ~FrameCache() override;
+
+    static FrameCache* instance();
+
+    /**
+     * Returns the cached frames of the given file for the given size. A miss starts decoding the
+     * frames in the background and returns a null pointer, framesReady() is emitted once they are
+     * cached. Files that cannot be decoded return a null pointer as well.
+     */
+    QSharedPointer<const Frames> frames(const QString& path, const QSize& size);
+
+    /**
+     * Decodes the frames in the background, so a later frames() call for them is a hit.
+     */
+    void prefetch(const QString& path, const QSize& size);
+    // Whether a frames() call is a hit, including files that cannot be decoded
+    bool contains(const QString& path, const QSize& size) const;
+    bool isPrefetching(const QString& path, const QSize& size) const;
+
+    void setRetainedPaths(const QStringList& paths);
+    void invalidate(const QString& path);
+    void clear();
+
+    quint64 hits() const;
+    quint64 misses() const;
+    qint64 bytes() const;
+    qint64 budget() const;
+
+    static QSharedPointer<const Frames> decode(const QString& path, const QSize& size);
+
+    // Converts a QML source (qrc:/ URLs) to a path QImageReader can open
+    static QString localPath(const QString& source);
+
+    /**
+     * Scales the frame to fill the given size and masks everything outside the inscribed circle.
+     */
+    static QImage maskFrame(const QImage& frame, const QSize& size);
+
+  signals:
+    void statisticsChanged();
+    void framesReady(const QString& path, const QSize& size);
+
+  private:
+    struct Entry
+    {
+        QString path;
+        QSharedPointer<const Frames> frames;
+        quint64 lastUsed;
+    };
+
+    struct Prefetch
+    {
+        QString path;
+        quint64 id;
+    };
+
+    static QString cacheKey(const QString& path, const QSize& size);
+    void insert(const QString& key, const QString& path, const QSharedPointer<const Frames>& frames);
+    void evict(const QString& keepKey);
+    void removeEntry(const QString& key);
+    void notifyStatistics();
+
+    static FrameCache* s_instance;
+
+    QHash<QString, Entry> m_entries;
+    QSet<QString> m_retainedPaths;
+    QHash<QString, Prefetch> m_prefetches; // Key -> decode running on m_pool
+    QHash<QString, QString> m_failed;      // Key -> path of media that could not be decoded
+    QThreadPool m_pool;
+    QTimer m_statisticsTimer;
+    quint64 m_nextPrefetchId;
+    qint64 m_budget;
+    qint64 m_bytes;
+    quint64 m_hits;
+    quint64 m_misses;
+    quint64 m_useCounter;
+};
+} // namespace Services::Media
+
+#endif // SERVICES_MEDIA_FRAMECACHE_H
@@ -0,0 +1,340 @@
+#include "Index.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+using namespace Services::Media;
+
+constexpr int INDEX_VERSION = 1;
+
+ManifestEntry ManifestEntry::fromJson(const QJsonValue& value)
+{
+    ManifestEntry entry;
+    if (value.isString()) {
+        entry.name = value.toString();
+        return entry;
+    }
+
+    QJsonObject object = value.toObject();
+    entry.name = object["name"].toString();
+    entry.size = object["size"].toInteger(-1);
+    entry.sha256 = object["sha256"].toString().toLower().toLatin1();
+    entry.etag = object["etag"].toString();
+    return entry;
+}
+
+Index::Index(const QString& directory, const QString& filePath)
+    : m_directory(directory),
+      m_filePath(filePath),
+      m_dirty(false),
+      m_generation(0),
+      m_upToDateGeneration(0),
+      m_fileChecks(0)
+{
+}
+
+void Index::load()
+{
+    m_entries.clear();
+    m_dirty = false;
+    ++m_generation;
+
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "No media index at" << m_filePath << ", files will be hashed on demand";
+        return;
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    QJsonObject root = doc.object();
+    if (root["version"].toInt() != INDEX_VERSION) {
+        qWarning() << "Ignoring media index with unsupported version:" << m_filePath;
+        return;
+    }
+
+    QJsonObject files = root["files"].toObject();
+    for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+        QJsonObject object = it.value().toObject();
+        Entry entry;
+        entry.size = object["size"].toInteger(-1);
+        entry.modified = object["modified"].toInteger();
+        entry.sha256 = object["sha256"].toString().toLatin1();
+        entry.etag = object["etag"].toString();
+        m_entries.insert(it.key(), entry);
+    }
+
+    qDebug() << "Media index loaded with" << m_entries.size() << "files";
+}
+
+void Index::save()
+{
+    if (!m_dirty) {
+        return;
+    }
+
+    QJsonObject files;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        if (it->size < 0) {
+            continue; // Looked up, but not on disk
+        }
+
+        QJsonObject object;
+        object["size"] = it->size;
+        object["modified"] = it->modified;
+        object["sha256"] = QString::fromLatin1(it->sha256);
+        if (!it->etag.isEmpty()) {
+            object["etag"] = it->etag;
+        }
+        files[it.key()] = object;
+    }
+
+    QJsonObject root;
+    root["version"] = INDEX_VERSION;
+    root["files"] = files;
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+
+    // Written atomically, a crash while saving leaves the previous index intact
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to save media index to" << m_filePath;
+        return;
+    }
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "Failed to save media index to" << m_filePath << ":" << file.errorString();
+        return;
+    }
+
+    m_dirty = false;
+}
+
+bool Index::matches(const ManifestEntry& manifestEntry)
+{
+    const Entry* entry = lookup(manifestEntry.name);
+    if (!entry) {
+        return false;
+    }
+
+    if (manifestEntry.size >= 0 && manifestEntry.size != entry->size) {
+        return false;
+    }
+
+    if (!manifestEntry.sha256.isEmpty()) {
+        return entry->sha256 == manifestEntry.sha256;
+    }
+
+    if (!manifestEntry.etag.isEmpty()) {
+        return entry->etag == manifestEntry.etag;
+    }
+
+    return true;
+}
+
+QStringList Index::outdated(const QList<ManifestEntry>& manifest)
+{
+    // Nothing the local files were checked against changed since they were all found up to date
+    const QByteArray digest = manifestDigest(manifest);
+    if (isUpToDate(digest)) {
+        return QStringList();
+    }
+
+    QStringList names;
+    for (const ManifestEntry& manifestEntry : manifest) {
+        if (!matches(manifestEntry)) {
+            names.append(manifestEntry.name);
+        }
+    }
+
+    if (names.isEmpty()) {
+        m_upToDateDigest = digest;
+        m_upToDateGeneration = m_generation;
+    }
+    return names;
+}
+
+QList<Index::HashRequest> Index::unhashed(const QList<ManifestEntry>& manifest)
+{
+    QList<HashRequest> requests;
+    if (isUpToDate(manifestDigest(manifest))) {
+        return requests; // Every digest of the manifest matched already
+    }
+
+    for (const ManifestEntry& manifestEntry : manifest) {
+        if (manifestEntry.sha256.isEmpty()) {
+            continue;
+        }
+
+        const Entry* entry = lookup(manifestEntry.name);
+        if (!entry || !entry->sha256.isEmpty()) {
+            continue;
+        }
+
+        // A file of the wrong size does not match anyway, hashing it would be wasted
+        if (manifestEntry.size >= 0 && manifestEntry.size != entry->size) {
+            continue;
+        }
+
+        requests.append(HashRequest{manifestEntry.name, QDir(m_directory).filePath(manifestEntry.name), entry->size, entry->modified});
+    }
+    return requests;
+}
+
+Index::HashRequest Index::hashRequest(const QString& name)
+{
+    const Entry* entry = lookup(name);
+    if (!entry) {
+        return HashRequest();
+    }
+    return HashRequest{name, QDir(m_directory).filePath(name), entry->size, entry->modified};
+}
+
+void Index::storeSha256(const HashRequest& request, const QByteArray& sha256)
+{
+    auto it = m_entries.find(request.name);
+    if (it == m_entries.end() || sha256.isEmpty() || !refresh(request.name, *it)) {
+        return;
+    }
+
+    if (it->size != request.size || it->modified != request.modified) {
+        return; // Replaced while it was hashed
+    }
+
+    it->sha256 = sha256;
+    changed();
+}
+
+QByteArray Index::cachedSha256(const QString& name) const
+{
+    auto it = m_entries.constFind(name);
+    if (it == m_entries.cend()) {
+        return QByteArray();
+    }
+
+    QFileInfo fileInfo(QDir(m_directory).filePath(name));
+    if (!fileInfo.exists() || fileInfo.size() != it->size || fileInfo.lastModified().toMSecsSinceEpoch() != it->modified) {
+        return QByteArray();
+    }
+
+    return it->sha256;
+}
+
+void Index::record(const QString& name, const QString& etag)
+{
+    Entry& entry = m_entries[name];
+    entry.size = -1; // Forces a refresh, the file was just replaced
+    refresh(name, entry);
+    entry.etag = etag;
+    changed();
+}
+
+void Index::remove(const QString& name)
+{
+    if (m_entries.remove(name) > 0) {
+        changed();
+    }
+}
+
+QByteArray Index::hashFile(const QString& path)
+{
+    QElapsedTimer lTimer;
+    lTimer.start();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&file)) {
+        return QByteArray();
+    }
+
+    qDebug() << "Hashed" << path << "in" << lTimer.elapsed() << "ms";
+    return hash.result().toHex();
+}
+
+quint64 Index::fileChecks() const
+{
+    return m_fileChecks;
+}
+
+Index::Entry* Index::lookup(const QString& name)
+{
+    auto it = m_entries.find(name);
+    if (it == m_entries.end()) {
+        // Only files that exist are indexed
+        Entry entry;
+        if (!refresh(name, entry)) {
+            return nullptr;
+        }
+        return &*m_entries.insert(name, entry);
+    }
+
+    if (!refresh(name, *it)) {
+        m_entries.erase(it);
+        changed();
+        return nullptr;
+    }
+    return &*it;
+}
+
+bool Index::refresh(const QString& name, Entry& entry)
+{
+    ++m_fileChecks;
+    QFileInfo fileInfo(QDir(m_directory).filePath(name));
+    if (!fileInfo.exists()) {
+        if (entry.size >= 0) {
+            entry = Entry();
+            changed();
+        }
+        return false;
+    }
+
+    // Cached digests stay valid for as long as the file was not touched
+    const qint64 modified = fileInfo.lastModified().toMSecsSinceEpoch();
+    if (entry.size != fileInfo.size() || entry.modified != modified) {
+        entry.size = fileInfo.size();
+        entry.modified = modified;
+        entry.sha256.clear();
+        entry.etag.clear();
+        changed();
+    }
+
+    return true;
+}
+
+bool Index::isUpToDate(const QByteArray& manifestDigest) const
+{
+    return !m_upToDateDigest.isEmpty() && m_upToDateDigest == manifestDigest && m_upToDateGeneration == m_generation;
+}
+
+void Index::changed()
+{
+    m_dirty = true;
+    ++m_generation;
+}
+
+QByteArray Index::manifestDigest(const QList<ManifestEntry>& manifest)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const ManifestEntry& entry : manifest) {
+        hash.addData(entry.name.toUtf8());
+        hash.addData(QByteArrayView("\0", 1));
+        hash.addData(QByteArray::number(entry.size));
+        hash.addData(QByteArrayView("\0", 1));
+        hash.addData(entry.sha256);
+        hash.addData(QByteArrayView("\0", 1));
+        hash.addData(entry.etag.toUtf8());
+        hash.addData(QByteArrayView("\n", 1));
+    }
+    return hash.result();
+}
@@ -0,0 +1,120 @@
+#ifndef SERVICES_MEDIA_INDEX_H
+#define SERVICES_MEDIA_INDEX_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonValue>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace Services::Media
+{
+/**
+ * One file of the media list sent by the backend. Size and digests are optional;
+ * older backends only send the file name.
+ */
+struct ManifestEntry
+{
+    QString name;
+    qint64 size = -1;
+    QByteArray sha256; // Lowercase hex
+    QString etag;
+
+    static ManifestEntry fromJson(const QJsonValue& value);
+};
+
+/**
+ * Persistent index of the content hashes of the local media files.
+ * A file is only rehashed when its size or modification time changed since it was indexed.
+ * Once a manifest was found up to date, the same manifest is not checked against the local
+ * files again until the index changes, e.g. by a download.
+ * The index never hashes by itself: files are hashed with hashFile() on a worker thread and
+ * the digests handed back with storeSha256().
+ */
+class Index
+{
+  public:
+    /**
+     * A local file to hash, with the size and modification time it had when it was requested.
+     */
+    struct HashRequest
+    {
+        QString name;
+        QString path;
+        qint64 size = -1;
+        qint64 modified = 0;
+    };
+
+    Index(const QString& directory, const QString& filePath);
+
+    void load();
+    void save();
+
+    /**
+     * Whether the local copy of the file matches the manifest entry. Files without any
+     * size or digest in the manifest match as soon as they exist. A sha256 in the manifest
+     * only matches once the file was hashed, see unhashed().
+     */
+    bool matches(const ManifestEntry& entry);
+
+    /**
+     * Names of the manifest entries whose local file is missing or does not match.
+     */
+    QStringList outdated(const QList<ManifestEntry>& manifest);
+
+    /**
+     * Local files of the manifest that need their sha256 for matches(), but were not hashed yet.
+     */
+    QList<HashRequest> unhashed(const QList<ManifestEntry>& manifest);
+
+    /**
+     * Request to hash the local file, invalid when the file does not exist.
+     */
+    HashRequest hashRequest(const QString& name);
+
+    /**
+     * Stores the digest of a hashed file, unless the file changed on disk since it was requested.
+     */
+    void storeSha256(const HashRequest& request, const QByteArray& sha256);
+
+    /**
+     * Sha256 of the local file if it is already known, without hashing the file.
+     */
+    QByteArray cachedSha256(const QString& name) const;
+
+    void record(const QString& name, const QString& etag);
+    void remove(const QString& name);
+
+    static QByteArray hashFile(const QString& path);
+
+    // Number of times a local file was looked up on disk
+    quint64 fileChecks() const;
+
+  private:
+    struct Entry
+    {
+        qint64 size = -1;
+        qint64 modified = 0; // Milliseconds since epoch
+        QByteArray sha256;
+        QString etag;
+    };
+
+    Entry* lookup(const QString& name);
+    bool refresh(const QString& name, Entry& entry);
+    bool isUpToDate(const QByteArray& manifestDigest) const;
+    void changed();
+    static QByteArray manifestDigest(const QList<ManifestEntry>& manifest);
+
+    QString m_directory;
+    QString m_filePath;
+    QHash<QString, Entry> m_entries;
+    bool m_dirty;
+    quint64 m_generation;         // Bumped on every change of the entries
+    QByteArray m_upToDateDigest;  // Digest of the last manifest outdated() found up to date
+    quint64 m_upToDateGeneration; // Generation at which it was found up to date
+    quint64 m_fileChecks;
+};
+} // namespace Services::Media
+
+#endif // SERVICES_MEDIA_INDEX_H
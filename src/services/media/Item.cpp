@@ -1,21 +1,73 @@
 #include "Item.h"
+#include <QFileInfo>
+#include <limits>
 
 using namespace Services::Media;
 
-Item::Item(QObject* parent)
-    : QObject(parent),
-      m_size(0),
-      m_isValid(false)
+namespace
+{
+// Shared by every item, so a library of thousands of GIFs holds a single "image/gif" string
+const QString MIME_TYPE_UNKNOWN = QStringLiteral("unknown");
+const QString MIME_TYPE_GIF = QStringLiteral("image/gif");
+const QString MIME_TYPE_PNG = QStringLiteral("image/png");
+const QString MIME_TYPE_JPEG = QStringLiteral("image/jpeg");
+} // namespace
+
+Item::Item()
+    : m_size(0),
+      m_frameCount(0),
+      m_duration(0),
+      m_width(0),
+      m_height(0),
+      m_mimeType(MimeType::Unknown),
+      m_isValid(false),
+      m_validated(false)
 {
 }
 
-Item::Item(const QString& id, const QString& filename, const QString& path, const QString& type, int size, QObject* parent)
-    : QObject(parent),
-      m_id(id),
-      m_filename(filename),
+Item::Item(const QString& filename, const QString& path, qint64 size)
+    : m_filename(filename),
       m_path(path),
-      m_type(type),
-      m_size(size),
-      m_isValid(true)
+      m_size(static_cast<int>(qMin<qint64>(size, std::numeric_limits<int>::max()))),
+      m_frameCount(0),
+      m_duration(0),
+      m_width(0),
+      m_height(0),
+      m_mimeType(mimeTypeForSuffix(QFileInfo(filename).suffix())),
+      m_isValid(true),
+      m_validated(false)
+{
+}
+
+QString Item::type() const
+{
+    switch (m_mimeType) {
+    case MimeType::Gif:
+        return MIME_TYPE_GIF;
+    case MimeType::Png:
+        return MIME_TYPE_PNG;
+    case MimeType::Jpeg:
+        return MIME_TYPE_JPEG;
+    default:
+        return MIME_TYPE_UNKNOWN;
+    }
+}
+
+void Item::setValidation(const Validation& validation)
+{
+    m_isValid = validation.valid;
+    m_validated = true;
+    m_frameCount = validation.frameCount;
+    m_duration = validation.duration;
+    m_width = static_cast<quint16>(qBound(0, validation.size.width(), 0xffff));
+    m_height = static_cast<quint16>(qBound(0, validation.size.height(), 0xffff));
+}
+
+Item::MimeType Item::mimeTypeForSuffix(const QString& suffix)
 {
+    const QString lowerSuffix = suffix.toLower();
+    if (lowerSuffix == "gif") return MimeType::Gif;
+    if (lowerSuffix == "png") return MimeType::Png;
+    if (lowerSuffix == "jpg" || lowerSuffix == "jpeg") return MimeType::Jpeg;
+    return MimeType::Unknown;
 }
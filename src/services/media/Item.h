@@ -1,47 +1,79 @@
 #ifndef SERVICES_MEDIA_ITEM_H
 #define SERVICES_MEDIA_ITEM_H
 
+#include "Validator.h"
+#include <QMetaType>
 #include <QObject>
 #include <QString>
 
 namespace Services::Media
 {
-class Item : public QObject
+/**
+ * A single media file. Stored by value in the model; QML reads it through model roles
+ * or, via Model::get(), as a value type.
+ */
+class Item
 {
-    Q_OBJECT
+    Q_GADGET
     Q_PROPERTY(QString id READ id CONSTANT)
     Q_PROPERTY(QString filename READ filename CONSTANT)
     Q_PROPERTY(QString path READ path CONSTANT)
     Q_PROPERTY(QString type READ type CONSTANT)
     Q_PROPERTY(int size READ size CONSTANT)
     Q_PROPERTY(bool isValid READ isValid CONSTANT)
+    Q_PROPERTY(bool validated READ validated CONSTANT)
+    Q_PROPERTY(int frameCount READ frameCount CONSTANT)
+    Q_PROPERTY(int width READ width CONSTANT)
+    Q_PROPERTY(int height READ height CONSTANT)
+    Q_PROPERTY(int duration READ duration CONSTANT)
+    Q_PROPERTY(QString thumbnailPath READ thumbnailPath CONSTANT)
 
   public:
-    Item(QObject* parent = nullptr);
-    Item(const QString& id, const QString& filename, const QString& path, const QString& type, int size, QObject* parent = nullptr);
+    enum class MimeType : quint8
+    {
+        Unknown,
+        Gif,
+        Png,
+        Jpeg
+    };
 
-    QString id() const { return m_id; }
+    Item();
+    Item(const QString& filename, const QString& path, qint64 size);
+
+    QString id() const { return m_filename; }
     QString filename() const { return m_filename; }
     QString path() const { return m_path; }
-    QString type() const { return m_type; }
+    QString type() const;
+    MimeType mimeType() const { return m_mimeType; }
     int size() const { return m_size; }
     bool isValid() const { return m_isValid; }
+    bool validated() const { return m_validated; }
+    int frameCount() const { return m_frameCount; }
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int duration() const { return m_duration; }
+    QString thumbnailPath() const { return m_thumbnailPath; }
+
+    void setValidation(const Validation& validation);
+    void setThumbnailPath(const QString& thumbnailPath) { m_thumbnailPath = thumbnailPath; }
 
-    void setId(const QString& id) { m_id = id; }
-    void setFilename(const QString& filename) { m_filename = filename; }
-    void setPath(const QString& path) { m_path = path; }
-    void setType(const QString& type) { m_type = type; }
-    void setSize(int size) { m_size = size; }
-    void setIsValid(bool valid) { m_isValid = valid; }
+    static MimeType mimeTypeForSuffix(const QString& suffix);
 
   private:
-    QString m_id;
     QString m_filename;
     QString m_path;
-    QString m_type;
+    QString m_thumbnailPath;
     int m_size;
+    int m_frameCount;
+    int m_duration;
+    quint16 m_width;
+    quint16 m_height;
+    MimeType m_mimeType;
     bool m_isValid;
+    bool m_validated;
 };
 } // namespace Services::Media
 
+Q_DECLARE_METATYPE(Services::Media::Item)
+
 #endif // SERVICES_MEDIA_ITEM_H
@@ -1,6 +1,7 @@
 #include "Model.h"
 #include <QDir>
 #include <QFileInfo>
+#include <QSet>
 
 using namespace Services::Media;
 
@@ -20,21 +21,33 @@ QVariant Model::data(const QModelIndex& index, int role) const
     if (!index.isValid() || index.row() >= m_items.size())
         return QVariant();
 
-    const Item* item = m_items.at(index.row());
+    const Item& item = m_items.at(index.row());
 
     switch (role) {
     case IdRole:
-        return item->id();
+        return item.id();
     case FilenameRole:
-        return item->filename();
+        return item.filename();
     case PathRole:
-        return item->path();
+        return item.path();
     case TypeRole:
-        return item->type();
+        return item.type();
     case SizeRole:
-        return item->size();
+        return item.size();
     case IsValidRole:
-        return item->isValid();
+        return item.isValid();
+    case ValidatedRole:
+        return item.validated();
+    case FrameCountRole:
+        return item.frameCount();
+    case WidthRole:
+        return item.width();
+    case HeightRole:
+        return item.height();
+    case DurationRole:
+        return item.duration();
+    case ThumbnailPathRole:
+        return item.thumbnailPath();
     default:
         return QVariant();
     }
@@ -49,83 +62,82 @@ QHash<int, QByteArray> Model::roleNames() const
     roles[TypeRole] = "type";
     roles[SizeRole] = "size";
     roles[IsValidRole] = "isValid";
+    roles[ValidatedRole] = "validated";
+    roles[FrameCountRole] = "frameCount";
+    roles[WidthRole] = "width";
+    roles[HeightRole] = "height";
+    roles[DurationRole] = "duration";
+    roles[ThumbnailPathRole] = "thumbnailPath";
     return roles;
 }
 
-Item* Model::get(int index) const
+Item Model::get(int index) const
 {
-    return (index >= 0 && index < m_items.count()) ? m_items[index] : nullptr;
+    return (index >= 0 && index < m_items.count()) ? m_items.at(index) : Item();
 }
 
 QString Model::getPath(const QString& filename) const
 {
-    for (const auto* item : m_items) {
-        if (item->filename() == filename) {
-            return item->path();
-        }
-    }
-    return QString();
+    int row = indexOf(filename);
+    return row >= 0 ? m_items.at(row).path() : QString();
 }
 
 bool Model::contains(const QString& filename) const
 {
-    for (const auto* item : m_items) {
-        if (item->filename() == filename) {
-            return true;
-        }
-    }
-    return false;
+    return m_rows.contains(filename);
 }
 
 int Model::indexOf(const QString& filename) const
 {
-    for (int i = 0; i < m_items.size(); ++i) {
-        if (m_items[i]->filename() == filename) {
-            return i;
-        }
-    }
-    return -1;
+    return m_rows.value(filename, -1);
 }
 
-void Model::setMedia(const QList<Item*>& items)
+void Model::setMedia(const QList<Item>& items)
 {
     // Clear existing items
     if (!m_items.isEmpty()) {
         beginResetModel();
-        qDeleteAll(m_items);
         m_items.clear();
+        m_rows.clear();
         endResetModel();
     }
 
+    addItems(items);
     if (items.isEmpty()) {
         emit countChanged();
-        return;
     }
+}
 
-    // Add new items
-    beginInsertRows(QModelIndex(), 0, items.size() - 1);
-    m_items = items;
-    
-    // Reparent items to this model to ensure cleanup
-    for (Item* item : m_items) {
-        if (item) {
-            item->setParent(this);
-        }
-    }
-    
-    endInsertRows();
-
-    emit countChanged();
+void Model::addItem(const Item& item)
+{
+    addItems({item});
 }
 
-void Model::addItem(Item* item)
+void Model::addItems(const QList<Item>& items)
 {
-    if (!item) return;
+    // Duplicates (of existing rows or within the batch) are dropped, the model is keyed by filename
+    QList<Item> newItems;
+    QSet<QString> newFilenames;
+    newItems.reserve(items.size());
+    for (const Item& item : items) {
+        if (m_rows.contains(item.filename()) || newFilenames.contains(item.filename())) {
+            continue;
+        }
+
+        newFilenames.insert(item.filename());
+        newItems.append(item);
+    }
+
+    if (newItems.isEmpty()) return;
 
-    int row = m_items.size();
-    beginInsertRows(QModelIndex(), row, row);
-    item->setParent(this);
-    m_items.append(item);
+    // One insert notification for the whole batch
+    int first = m_items.size();
+    beginInsertRows(QModelIndex(), first, first + newItems.size() - 1);
+    m_items.reserve(first + newItems.size());
+    for (const Item& item : std::as_const(newItems)) {
+        m_rows.insert(item.filename(), m_items.size());
+        m_items.append(item);
+    }
     endInsertRows();
 
     emit countChanged();
@@ -137,22 +149,52 @@ void Model::removeItem(const QString& filename)
     if (row < 0) return;
 
     beginRemoveRows(QModelIndex(), row, row);
-    Item* item = m_items.takeAt(row);
-    delete item;
+    m_items.removeAt(row);
+    m_rows.remove(filename);
+    reindex(row);
     endRemoveRows();
 
     emit countChanged();
 }
 
+void Model::setValidation(const QString& filename, const Validation& validation)
+{
+    int row = indexOf(filename);
+    if (row < 0) return;
+
+    m_items[row].setValidation(validation);
+
+    QModelIndex modelIndex = index(row);
+    emit dataChanged(modelIndex, modelIndex, {IsValidRole, ValidatedRole, FrameCountRole, WidthRole, HeightRole, DurationRole});
+}
+
+void Model::setThumbnailPath(const QString& filename, const QString& thumbnailPath)
+{
+    int row = indexOf(filename);
+    if (row < 0) return;
+
+    m_items[row].setThumbnailPath(thumbnailPath);
+
+    QModelIndex modelIndex = index(row);
+    emit dataChanged(modelIndex, modelIndex, {ThumbnailPathRole});
+}
+
 void Model::clear()
 {
     if (m_items.isEmpty())
         return;
 
     beginResetModel();
-    qDeleteAll(m_items);
     m_items.clear();
+    m_rows.clear();
     endResetModel();
 
     emit countChanged();
 }
+
+void Model::reindex(int fromRow)
+{
+    for (int row = fromRow; row < m_items.size(); ++row) {
+        m_rows[m_items.at(row).filename()] = row;
+    }
+}
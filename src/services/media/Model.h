@@ -3,6 +3,7 @@
 
 #include "Item.h"
 #include <QAbstractListModel>
+#include <QHash>
 #include <QList>
 
 namespace Services::Media
@@ -20,7 +21,13 @@ class Model : public QAbstractListModel
         PathRole,
         TypeRole,
         SizeRole,
-        IsValidRole
+        IsValidRole,
+        ValidatedRole,
+        FrameCountRole,
+        WidthRole,
+        HeightRole,
+        DurationRole,
+        ThumbnailPathRole
     };
 
     explicit Model(QObject* parent = nullptr);
@@ -31,7 +38,7 @@ class Model : public QAbstractListModel
     QHash<int, QByteArray> roleNames() const override;
 
     // Model access
-    Q_INVOKABLE Item* get(int index) const;
+    Q_INVOKABLE Services::Media::Item get(int index) const;
     Q_INVOKABLE QString getPath(const QString& filename) const;
     Q_INVOKABLE bool contains(const QString& filename) const;
     Q_INVOKABLE int indexOf(const QString& filename) const;
@@ -41,16 +48,22 @@ class Model : public QAbstractListModel
     }
 
     // Model manipulation
-    void setMedia(const QList<Item*>& items);
-    void addItem(Item* item);
+    void setMedia(const QList<Item>& items);
+    void addItem(const Item& item);
+    void addItems(const QList<Item>& items);
     void removeItem(const QString& filename);
+    void setValidation(const QString& filename, const Validation& validation);
+    void setThumbnailPath(const QString& filename, const QString& thumbnailPath);
     void clear();
 
   signals:
     void countChanged();
 
   private:
-    QList<Item*> m_items;
+    void reindex(int fromRow);
+
+    QList<Item> m_items; // Contiguous, one value per row
+    QHash<QString, int> m_rows; // Filename -> row, kept in sync with m_items
 };
 } // namespace Services::Media
 
@@ -1,33 +1,73 @@
 #include "Service.h"
+#include "services/Initializer.h"
 #include "services/rest/Service.h"
 #include "services/websocket/Service.h"
+#include "tracing/BootTrace.h"
 #include <QDebug>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QSet>
+#include <QSettings>
+#include <QtConcurrent>
+#include <utility>
 
 using namespace Services::Media;
 
 #ifdef PLATFORM_IS_TARGET
 const QString MEDIA_PATH = QStringLiteral("/usr/share/bee/media");
+const QString MEDIA_INDEX_PATH = QStringLiteral("/usr/share/bee/media-index.json");
+const QString THUMBNAIL_PATH = QStringLiteral("/usr/share/bee/media-thumbnails");
 #else
 const QString MEDIA_PATH = QStringLiteral("/workdir/build/bee/media");
+const QString MEDIA_INDEX_PATH = QStringLiteral("/workdir/build/bee/media-index.json");
+const QString THUMBNAIL_PATH = QStringLiteral("/workdir/build/bee/media-thumbnails");
 #endif
 const QString DEFAULT_MEDIA = QStringLiteral("qrc:/media/default.gif");
 constexpr int MIN_MEDIA_FILE_SIZE = 50;         // Minimum reasonable file size in bytes
 constexpr int INITIAL_SYNC_DELAY_MS = 5000;     // 5 seconds
+constexpr qint64 FRAME_CACHE_BUDGET_BYTES = 96 * 1024 * 1024; // Roughly 4-5 decoded full screen backgrounds
+const QString PROPERTIES_GROUP_NAME = QStringLiteral("media");
+const QString PROPERTY_MAX_CONCURRENT_DOWNLOADS_KEY = QStringLiteral("max-concurrent-downloads");
+constexpr int PROPERTY_MAX_CONCURRENT_DOWNLOADS_DEFAULT = 2;
+constexpr int HASH_THREADS = 1; // Hashing is I/O bound, more threads only compete for the flash
 
 Service::Service(Services::WebSocket::Service& webSocket, Services::Rest::Service& rest, QObject* parent)
     : QObject(parent),
       m_model(this),
+      m_frameCache(FRAME_CACHE_BUDGET_BYTES, this),
+      m_downloadQueue(rest, MEDIA_PATH, this),
+      m_index(MEDIA_PATH, MEDIA_INDEX_PATH),
+      m_validator(this),
+      m_thumbnailer(THUMBNAIL_PATH, this),
       m_startupTimeoutTimer(this),
       m_webSocket(webSocket),
       m_rest(rest),
       m_syncing(false),
-      m_startupCheckInProgress(false)
+      m_startupCheckInProgress(false),
+      m_indexLoaded(false),
+      m_nextHashId(0),
+      m_syncHashId(0)
 {
+    m_hashPool.setMaxThreadCount(HASH_THREADS);
+    m_hashPool.setThreadPriority(QThread::LowPriority);
+
+    loadProperties();
+
+    connect(&m_frameCache, &FrameCache::statisticsChanged, this, &Service::frameCacheChanged);
+    connect(&m_downloadQueue, &DownloadQueue::downloadFinished, this, &Service::onDownloadFinished);
+    connect(&m_downloadQueue, &DownloadQueue::downloadFailed, this, &Service::onDownloadFailed);
+    connect(&m_downloadQueue, &DownloadQueue::downloadProgress, this, [this](const QString& filename, qint64 bytesReceived, qint64 bytesTotal) {
+        m_downloadProgress[filename] = qMakePair(bytesReceived, bytesTotal);
+        emit downloadProgressChanged();
+    });
+    connect(&m_downloadQueue, &DownloadQueue::idle, this, &Service::onDownloadsIdle);
+    connect(&m_validator, &Validator::validated, this, &Service::onMediaValidated);
+    connect(&m_thumbnailer, &Thumbnailer::thumbnailReady, &m_model, &Model::setThumbnailPath);
+
     // Subscribe to media change notifications from backend
     m_webSocket.subscribe(Services::WebSocket::Topic::Media);
     connect(&m_webSocket, &Services::WebSocket::Service::publishReceived, this, [this](const Services::WebSocket::Topic& topic, const QJsonObject& data) {
@@ -50,6 +90,19 @@ Service::Service(Services::WebSocket::Service& webSocket, Services::Rest::Servic
     performStartupCheck();
 }
 
+void Service::addInitializationSteps(Services::Initializer& initializer)
+{
+    initializer.addStep(
+        INITIALIZATION_STEP,
+        {},
+        [this]() {
+            m_index.load();
+        },
+        [this]() {
+            onIndexLoaded();
+        });
+}
+
 Model* Service::model()
 {
     return &m_model;
@@ -60,6 +113,37 @@ bool Service::syncing() const
     return m_syncing;
 }
 
+qreal Service::downloadProgress() const
+{
+    qint64 received = 0;
+    qint64 total = 0;
+    for (const auto& fileProgress : m_downloadProgress) {
+        if (fileProgress.second <= 0) {
+            continue; // Size not known (yet)
+        }
+        received += fileProgress.first;
+        total += fileProgress.second;
+    }
+
+    return total > 0 ? static_cast<qreal>(received) / total : 0.0;
+}
+
+int Service::maxConcurrentDownloads() const
+{
+    return m_downloadQueue.maxConcurrentDownloads();
+}
+
+void Service::setMaxConcurrentDownloads(int maxConcurrentDownloads)
+{
+    if (m_downloadQueue.maxConcurrentDownloads() == maxConcurrentDownloads) {
+        return;
+    }
+
+    m_downloadQueue.setMaxConcurrentDownloads(maxConcurrentDownloads);
+    saveProperty(PROPERTY_MAX_CONCURRENT_DOWNLOADS_KEY, m_downloadQueue.maxConcurrentDownloads());
+    emit maxConcurrentDownloadsChanged();
+}
+
 QString Service::lastError() const
 {
     return m_lastError;
@@ -70,6 +154,41 @@ bool Service::startupCheckInProgress() const
     return m_startupCheckInProgress;
 }
 
+quint64 Service::frameCacheHits() const
+{
+    return m_frameCache.hits();
+}
+
+quint64 Service::frameCacheMisses() const
+{
+    return m_frameCache.misses();
+}
+
+qint64 Service::frameCacheBytes() const
+{
+    return m_frameCache.bytes();
+}
+
+void Service::setRetainedMedia(const QStringList& names)
+{
+    QDir mediaDir(getMediaDirectory());
+    QStringList paths;
+    for (const QString& name : names) {
+        paths.append(mediaDir.absoluteFilePath(name));
+    }
+
+    m_frameCache.setRetainedPaths(paths);
+    m_downloadQueue.setPriorities(names);
+}
+
+void Service::prefetchFrames(const QString& name, const QSize& size)
+{
+    const QString path = getMediaPath(name);
+    if (!path.isEmpty()) {
+        m_frameCache.prefetch(FrameCache::localPath(path), size);
+    }
+}
+
 QString Service::getMediaPath(const QString& name) const
 {
     if (name.isEmpty()) {
@@ -79,6 +198,13 @@ QString Service::getMediaPath(const QString& name) const
     QString mediaDir = getMediaDirectory();
     QString fullPath = QDir(mediaDir).absoluteFilePath(name);
 
+    // Files that failed to decode on the validation thread are never handed to the GUI
+    const Item item = m_model.get(m_model.indexOf(name));
+    if (item.validated() && !item.isValid()) {
+        qWarning() << "Requested media failed validation:" << fullPath << ", falling back to default.";
+        return DEFAULT_MEDIA;
+    }
+
     // Verify the file exists and is valid
     if (QFileInfo::exists(fullPath) && isValidFile(fullPath)) {
         return fullPath;
@@ -121,38 +247,103 @@ void Service::onMediaReceived(const QJsonObject& data)
          return;
     }
 
+    // Synchronizing needs the index, the latest file list is kept until it is loaded
+    if (!m_indexLoaded) {
+        qDebug() << "Media index not loaded yet, deferring media synchronization";
+        m_pendingMedia = data;
+        return;
+    }
+
     setSyncing(true);
 
+    // Entries are either plain file names or {name, size, sha256, etag} objects
     QJsonArray filesArray = data["files"].toArray();
-    QStringList serverFilenames;
+    QList<ManifestEntry> manifest;
+    manifest.reserve(filesArray.size());
     for (const auto& val : filesArray) {
-        serverFilenames.append(val.toString());
+        ManifestEntry entry = ManifestEntry::fromJson(val);
+        if (!entry.name.isEmpty()) {
+            manifest.append(entry);
+        }
+    }
+
+    syncWithServerFiles(manifest);
+}
+
+void Service::onIndexLoaded()
+{
+    m_indexLoaded = true;
+    if (!m_pendingMedia.isEmpty()) {
+        onMediaReceived(std::exchange(m_pendingMedia, QJsonObject()));
     }
+}
+
+void Service::syncWithServerFiles(const QList<ManifestEntry>& manifest)
+{
+    // Files without a known digest are hashed on a worker first, e.g. on the first boot without an index.
+    // A newer file list supersedes this one.
+    const quint64 id = ++m_nextHashId;
+    m_syncHashId = id;
+
+    const QList<Index::HashRequest> requests = m_index.unhashed(manifest);
+    if (requests.isEmpty()) {
+        applyServerFiles(manifest);
+        return;
+    }
+
+    qDebug() << "Hashing" << requests.size() << "media files before synchronizing";
+    QtConcurrent::run(&m_hashPool, [requests]() {
+        QList<QByteArray> digests;
+        digests.reserve(requests.size());
+        for (const Index::HashRequest& request : requests) {
+            digests.append(Index::hashFile(request.path));
+        }
+        return digests;
+    }).then(this, [this, id, requests, manifest](const QList<QByteArray>& digests) {
+        // Digests of unchanged files stay valid, even when the file list was superseded meanwhile
+        for (qsizetype i = 0; i < requests.size(); ++i) {
+            m_index.storeSha256(requests.at(i), digests.at(i));
+        }
 
-    syncWithServerFiles(serverFilenames);
+        if (id != m_syncHashId) {
+            m_index.save();
+            return;
+        }
+        applyServerFiles(manifest);
+    });
 }
 
-void Service::syncWithServerFiles(const QStringList& serverFilenames)
+void Service::applyServerFiles(const QList<ManifestEntry>& manifest)
 {
+    QElapsedTimer lTimer;
+    lTimer.start();
+
     // Current local files
     QString mediaDir = getMediaDirectory();
     QDir dir(mediaDir);
     if (!dir.exists()) {
         dir.mkpath(mediaDir);
     }
-    QStringList localFilenames = dir.entryList(QDir::Files);
-
+    const QStringList localFiles = dir.entryList(QDir::Files);
+    const QSet<QString> localFilenames(localFiles.cbegin(), localFiles.cend());
+
+    // Missing files and files whose content differs from the manifest are (re)downloaded.
+    // Digests come from the index, so unchanged files are not rehashed, and an unchanged
+    // manifest against an unchanged index is not checked file by file again.
+    const QStringList outdatedFiles = m_index.outdated(manifest);
+    const QSet<QString> outdated(outdatedFiles.cbegin(), outdatedFiles.cend());
+    m_manifest.clear();
     QStringList mediaToDownload;
-    QStringList mediaToDelete;
-
-    for (const QString& serverFile : serverFilenames) {
-        if (!localFilenames.contains(serverFile)) {
-            mediaToDownload.append(serverFile);
+    for (const ManifestEntry& entry : manifest) {
+        m_manifest.insert(entry.name, entry);
+        if (!localFilenames.contains(entry.name) || outdated.contains(entry.name)) {
+            mediaToDownload.append(entry.name);
         }
     }
 
-    for (const QString& localFile : localFilenames) {
-        if (!serverFilenames.contains(localFile)) {
+    QStringList mediaToDelete;
+    for (const QString& localFile : localFiles) {
+        if (!m_manifest.contains(localFile)) {
             if (isValidFile(mediaDir + "/" + localFile)) {
                 mediaToDelete.append(localFile);
             }
@@ -162,79 +353,150 @@ void Service::syncWithServerFiles(const QStringList& serverFilenames)
     // Delete removed files and update model
     for (const QString& file : mediaToDelete) {
         QFile::remove(mediaDir + "/" + file);
+        m_index.remove(file);
+        m_validator.cancel(file);
+        m_verifying.remove(file);
+        m_thumbnailer.cancel(file);
+        removeThumbnail(file);
+        m_frameCache.invalidate(QDir(mediaDir).absoluteFilePath(file));
         m_model.removeItem(file);
     }
 
+    m_index.save();
+    qDebug() << "Media diff of" << manifest.size() << "files took" << lTimer.elapsed() << "ms," << mediaToDownload.size() << "to download," << mediaToDelete.size() << "to delete";
+
     // Load already-present local files into the model
-    for (const QString& file : serverFilenames) {
-        if (!mediaToDownload.contains(file)) {
+    const QSet<QString> downloads(mediaToDownload.cbegin(), mediaToDownload.cend());
+    QList<Item> presentItems;
+    for (const ManifestEntry& entry : manifest) {
+        const QString& file = entry.name;
+        if (localFilenames.contains(file) && !downloads.contains(file)) {
             QString filePath = mediaDir + "/" + file;
-            QFileInfo fileInfo(filePath);
-            QString suffix = fileInfo.suffix().toLower();
-            QString type = "unknown";
-            if (suffix == "gif") type = "image/gif";
-            else if (suffix == "png") type = "image/png";
-            else if (suffix == "jpg" || suffix == "jpeg") type = "image/jpeg";
-
             if (!m_model.contains(file)) {
-                m_model.addItem(new Item(file, file, filePath, type, fileInfo.size(), nullptr));
+                presentItems.append(Item(file, filePath, QFileInfo(filePath).size()));
+                m_validator.validate(file, filePath);
             }
         }
     }
+    m_model.addItems(presentItems);
+
+    // Downloads of an older file list that are still running and still wanted continue;
+    // the queue reports idle once every file has been downloaded or has given up.
+    m_failedDownloads.clear();
+    m_downloadProgress.clear();
+    emit downloadProgressChanged();
+    m_downloadQueue.replace(mediaToDownload);
+}
 
-    if (mediaToDownload.isEmpty()) {
-        completeSyncWithSuccess();
+void Service::onDownloadFinished(const QString& filename, const QString& filePath)
+{
+    m_downloadProgress.remove(filename);
+    emit downloadProgressChanged();
+
+    const ManifestEntry expected = m_manifest.value(filename);
+    m_index.record(filename, expected.etag);
+    if (expected.sha256.isEmpty()) {
+        m_index.save();
+        onDownloadVerified(filename, filePath);
         return;
     }
 
-    // Download new files
-    m_pendingDownloads = mediaToDownload;
-    for (const QString& file : mediaToDownload) {
-        downloadMedia(file);
+    // Verify the transfer against the manifest on a worker before the file is used
+    const Index::HashRequest request = m_index.hashRequest(filename);
+    const quint64 id = ++m_nextHashId;
+    m_verifying.insert(filename, id);
+
+    QtConcurrent::run(&m_hashPool, &Index::hashFile, request.path).then(this, [this, filename, filePath, expected, request, id](const QByteArray& sha256) {
+        auto it = m_verifying.find(filename);
+        if (it == m_verifying.end() || it.value() != id) {
+            return; // Removed or downloaded again meanwhile
+        }
+        m_verifying.erase(it);
+
+        if (sha256 != expected.sha256) {
+            QFile::remove(filePath);
+            m_index.remove(filename);
+            m_index.save();
+            onDownloadFailed(filename, "Checksum mismatch");
+        }
+        else {
+            m_index.storeSha256(request, sha256);
+            m_index.save();
+            onDownloadVerified(filename, filePath);
+        }
+
+        if (m_downloadQueue.isIdle()) {
+            onDownloadsIdle();
+        }
+    });
+}
+
+void Service::onDownloadVerified(const QString& filename, const QString& filePath)
+{
+    m_frameCache.invalidate(QFileInfo(filePath).absoluteFilePath());
+    qDebug() << "Downloaded:" << filename;
+
+    if (!m_model.contains(filename)) {
+        m_model.addItem(Item(filename, filePath, QFileInfo(filePath).size()));
     }
+    m_validator.validate(filename, filePath);
 }
 
-void Service::downloadMedia(const QString& filename)
+void Service::onDownloadFailed(const QString& filename, const QString& error)
 {
-    // Binary file download still uses REST
-    QString endpoint = "media/" + filename;
+    m_downloadProgress.remove(filename);
+    emit downloadProgressChanged();
 
-    m_rest.download(endpoint, [this, filename](bool success, const QByteArray& data, const QString& error) {
-        m_pendingDownloads.removeOne(filename);
+    qWarning() << "Failed to download" << filename << ":" << error;
+    m_failedDownloads.append(filename);
+}
 
-        if (!success) {
-            qWarning() << "Failed to download" << filename << ":" << error;
-            if (m_pendingDownloads.isEmpty()) {
-                if (m_lastError.isEmpty()) completeSyncWithSuccess();
-                else completeSyncWithError("Some downloads failed");
-            }
-            return;
-        }
+void Service::onDownloadsIdle()
+{
+    // The sync completes once the last download is verified as well
+    if (!m_syncing || !m_verifying.isEmpty()) {
+        return;
+    }
 
-        QString filePath = getMediaDirectory() + "/" + filename;
-        QFile file(filePath);
-        if (file.open(QIODevice::WriteOnly)) {
-            file.write(data);
-            file.close();
-            qDebug() << "Downloaded:" << filename;
-
-            // Construct and add Item directly to the model
-            QFileInfo fileInfo(filePath);
-            QString suffix = fileInfo.suffix().toLower();
-            QString type = "unknown";
-            if (suffix == "gif") type = "image/gif";
-            else if (suffix == "png") type = "image/png";
-            else if (suffix == "jpg" || suffix == "jpeg") type = "image/jpeg";
-
-            m_model.addItem(new Item(filename, filename, filePath, type, fileInfo.size(), nullptr));
-        } else {
-            qWarning() << "Failed to write downloaded file:" << filePath;
-        }
+    if (m_failedDownloads.isEmpty()) {
+        completeSyncWithSuccess();
+    }
+    else {
+        completeSyncWithError("Some downloads failed: " + m_failedDownloads.join(", "));
+    }
+}
+
+void Service::onMediaValidated(const QString& filename, const Validation& validation)
+{
+    if (!validation.valid) {
+        qWarning() << "Media" << filename << "failed validation:" << validation.error;
+        m_frameCache.invalidate(QDir(getMediaDirectory()).absoluteFilePath(filename));
+    }
+
+    m_model.setValidation(filename, validation);
+
+    // Only media that decodes gets a preview; the hash is reused from the index when known
+    if (validation.valid) {
+        m_thumbnailer.generate(filename, m_model.getPath(filename), m_index.cachedSha256(filename));
+    }
+}
 
-        if (m_pendingDownloads.isEmpty()) {
-            completeSyncWithSuccess();
+void Service::removeThumbnail(const QString& filename)
+{
+    const QString thumbnailPath = m_model.get(m_model.indexOf(filename)).thumbnailPath();
+    if (thumbnailPath.isEmpty()) {
+        return;
+    }
+
+    // Identical files share their thumbnail
+    for (int row = 0; row < m_model.rowCount(); ++row) {
+        const Item item = m_model.get(row);
+        if (item.filename() != filename && item.thumbnailPath() == thumbnailPath) {
+            return;
         }
-    });
+    }
+
+    m_thumbnailer.remove(thumbnailPath);
 }
 
 void Service::completeSyncWithSuccess()
@@ -274,6 +536,7 @@ void Service::performStartupCheck()
 
     setSyncing(true);
     setStartupCheckInProgress(true);
+    Tracing::BootTrace::beginAsync("Media startup check");
 
     m_startupTimeoutTimer.setSingleShot(true);
     m_startupTimeoutTimer.setInterval(INITIAL_SYNC_DELAY_MS);
@@ -323,9 +586,26 @@ void Service::completeStartupCheck()
     m_startupTimeoutTimer.stop();
     disconnect(m_startupConnectionWatcher);
     setStartupCheckInProgress(false);
+    Tracing::BootTrace::endAsync("Media startup check");
     qInfo() << "Media startup check complete.";
 }
 
+void Service::loadProperties()
+{
+    QSettings settings;
+    settings.beginGroup(PROPERTIES_GROUP_NAME);
+    m_downloadQueue.setMaxConcurrentDownloads(settings.value(PROPERTY_MAX_CONCURRENT_DOWNLOADS_KEY, PROPERTY_MAX_CONCURRENT_DOWNLOADS_DEFAULT).toInt());
+    settings.endGroup();
+}
+
+void Service::saveProperty(const QString& key, const QVariant& value)
+{
+    QSettings settings;
+    settings.beginGroup(PROPERTIES_GROUP_NAME);
+    settings.setValue(key, value);
+    settings.endGroup();
+}
+
 void Service::setSyncing(bool syncing)
 {
     if (m_syncing != syncing) {
@@ -1,13 +1,25 @@
 #ifndef SERVICES_MEDIA_SERVICE_H
 #define SERVICES_MEDIA_SERVICE_H
 
+#include "DownloadQueue.h"
+#include "FrameCache.h"
+#include "Index.h"
 #include "Model.h"
+#include "Thumbnailer.h"
+#include "Validator.h"
 #include <QDateTime>
+#include <QHash>
+#include <QJsonObject>
 #include <QMetaObject>
 #include <QObject>
 #include <QStringList>
+#include <QThreadPool>
 #include <QTimer>
 
+namespace Services
+{
+class Initializer;
+}
 namespace Services::WebSocket
 {
 class Service;
@@ -24,31 +36,74 @@ class Service : public QObject
     Q_OBJECT
     Q_PROPERTY(Media::Model* model READ model CONSTANT)
     Q_PROPERTY(bool syncing READ syncing NOTIFY syncingChanged)
+    Q_PROPERTY(qreal downloadProgress READ downloadProgress NOTIFY downloadProgressChanged)
+    Q_PROPERTY(int maxConcurrentDownloads READ maxConcurrentDownloads WRITE setMaxConcurrentDownloads NOTIFY maxConcurrentDownloadsChanged)
     Q_PROPERTY(QString lastError READ lastError NOTIFY lastErrorChanged)
     Q_PROPERTY(bool startupCheckInProgress READ startupCheckInProgress NOTIFY startupCheckInProgressChanged)
+    Q_PROPERTY(quint64 frameCacheHits READ frameCacheHits NOTIFY frameCacheChanged)
+    Q_PROPERTY(quint64 frameCacheMisses READ frameCacheMisses NOTIFY frameCacheChanged)
+    Q_PROPERTY(qint64 frameCacheBytes READ frameCacheBytes NOTIFY frameCacheChanged)
 
   public:
+    static constexpr const char* INITIALIZATION_STEP = "Media index";
+
     explicit Service(Services::WebSocket::Service& webSocket, Services::Rest::Service& rest, QObject* parent = nullptr);
 
+    /**
+     * Loads the media index on a worker thread. Media received before it is ready is synchronized afterwards.
+     */
+    void addInitializationSteps(Services::Initializer& initializer);
+
     Model* model();
     bool syncing() const;
+    qreal downloadProgress() const;
+    int maxConcurrentDownloads() const;
+    void setMaxConcurrentDownloads(int maxConcurrentDownloads);
     QString lastError() const;
     bool startupCheckInProgress() const;
+    quint64 frameCacheHits() const;
+    quint64 frameCacheMisses() const;
+    qint64 frameCacheBytes() const;
 
     Q_INVOKABLE QString getMediaPath(const QString& name) const;
 
+    /**
+     * Decodes the media in the background for an image of the given size in device pixels,
+     * e.g. the background of the next watchface before it is shown.
+     */
+    Q_INVOKABLE void prefetchFrames(const QString& name, const QSize& size);
+
+    /**
+     * Media that is referenced by the current configuration (e.g. watchface backgrounds).
+     * Decoded frames of these files are kept in the frame cache in favour of other media,
+     * and missing files are downloaded first, in the given order.
+     */
+    void setRetainedMedia(const QStringList& names);
+
   signals:
     void syncingChanged();
+    void downloadProgressChanged();
+    void maxConcurrentDownloadsChanged();
     void lastErrorChanged();
     void syncCompleted();
     void startupCheckInProgressChanged();
+    void frameCacheChanged();
 
   private:
     bool isValidFile(const QString& filePath) const;
     QString getMediaDirectory() const;
 
-    void syncWithServerFiles(const QStringList& serverFilenames);
-    void downloadMedia(const QString& mediaId);
+    void loadProperties();
+    void saveProperty(const QString& key, const QVariant& value);
+
+    void syncWithServerFiles(const QList<ManifestEntry>& manifest);
+    void applyServerFiles(const QList<ManifestEntry>& manifest);
+    void onDownloadFinished(const QString& filename, const QString& filePath);
+    void onDownloadVerified(const QString& filename, const QString& filePath);
+    void onDownloadFailed(const QString& filename, const QString& error);
+    void onDownloadsIdle();
+    void onMediaValidated(const QString& filename, const Validation& validation);
+    void removeThumbnail(const QString& filename);
     void completeSyncWithSuccess();
     void completeSyncWithError(const QString& error);
 
@@ -58,17 +113,31 @@ class Service : public QObject
     void setStartupCheckInProgress(bool inProgress);
 
     void onMediaReceived(const QJsonObject& data);
+    void onIndexLoaded();
 
     Model m_model;
+    FrameCache m_frameCache;
+    DownloadQueue m_downloadQueue;
+    Index m_index;
+    Validator m_validator;
+    Thumbnailer m_thumbnailer;
+    QThreadPool m_hashPool;
     QTimer m_startupTimeoutTimer;
     Services::WebSocket::Service& m_webSocket;
     Services::Rest::Service& m_rest; // Kept for binary file downloads only
 
     bool m_syncing;
     bool m_startupCheckInProgress;
+    bool m_indexLoaded;
+    quint64 m_nextHashId;
+    quint64 m_syncHashId; // Id of the hashing of the latest file list
+    QHash<QString, quint64> m_verifying; // Downloaded files being hashed, with the id of the latest verification
+    QJsonObject m_pendingMedia; // Received before the index was loaded
     QMetaObject::Connection m_startupConnectionWatcher;
     QString m_lastError;
-    QStringList m_pendingDownloads;
+    QStringList m_failedDownloads;
+    QHash<QString, ManifestEntry> m_manifest; // Latest media list of the backend, by filename
+    QHash<QString, QPair<qint64, qint64>> m_downloadProgress; // filename -> (received, total) bytes
 };
 } // namespace Services::Media
 
@@ -0,0 +1,98 @@
+#include "Thumbnailer.h"
+#include "FrameCache.h"
+#include "Index.h"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QSaveFile>
+#include <QtConcurrent>
+
+using namespace Services::Media;
+
+constexpr int THUMBNAIL_SIZE = 160;    // Pixels, square
+constexpr int THUMBNAIL_THREADS = 1;   // Leave the other cores to rendering
+const QString THUMBNAIL_SUFFIX = QStringLiteral(".png");
+
+Thumbnailer::Thumbnailer(const QString& directory, QObject* parent)
+    : QObject(parent),
+      m_directory(directory),
+      m_nextId(0)
+{
+    m_pool.setMaxThreadCount(THUMBNAIL_THREADS);
+    m_pool.setThreadPriority(QThread::LowPriority);
+}
+
+void Thumbnailer::generate(const QString& filename, const QString& path, const QByteArray& sha256)
+{
+    const quint64 id = ++m_nextId;
+    m_pending.insert(filename, id);
+
+    QtConcurrent::run(&m_pool, &Thumbnailer::create, m_directory, path, sha256).then(this, [this, filename, id](const QString& thumbnailPath) {
+        auto it = m_pending.find(filename);
+        if (it == m_pending.end() || it.value() != id) {
+            return; // Cancelled or superseded
+        }
+        m_pending.erase(it);
+
+        if (!thumbnailPath.isEmpty()) {
+            emit thumbnailReady(filename, thumbnailPath);
+        }
+    });
+}
+
+void Thumbnailer::cancel(const QString& filename)
+{
+    m_pending.remove(filename);
+}
+
+void Thumbnailer::remove(const QString& thumbnailPath)
+{
+    if (!thumbnailPath.isEmpty()) {
+        QFile::remove(thumbnailPath);
+    }
+}
+
+QString Thumbnailer::create(const QString& directory, const QString& path, QByteArray sha256)
+{
+    if (sha256.isEmpty()) {
+        sha256 = Index::hashFile(path);
+        if (sha256.isEmpty()) {
+            return QString();
+        }
+    }
+
+    const QString thumbnailPath = QDir(directory).filePath(QString::fromLatin1(sha256) + THUMBNAIL_SUFFIX);
+    if (QFileInfo::exists(thumbnailPath)) {
+        return thumbnailPath;
+    }
+
+    QElapsedTimer lTimer;
+    lTimer.start();
+
+    // Let the reader downscale while decoding where the format supports it (JPEG)
+    QImageReader reader(path);
+    QSize sourceSize = reader.size();
+    if (sourceSize.isValid()) {
+        reader.setScaledSize(sourceSize.scaled(THUMBNAIL_SIZE, THUMBNAIL_SIZE, Qt::KeepAspectRatioByExpanding));
+    }
+
+    QImage frame = reader.read();
+    if (frame.isNull()) {
+        qWarning() << "Cannot create thumbnail of" << path << ":" << reader.errorString();
+        return QString();
+    }
+
+    QImage thumbnail = FrameCache::maskFrame(frame, QSize(THUMBNAIL_SIZE, THUMBNAIL_SIZE));
+
+    QDir().mkpath(directory);
+    QSaveFile file(thumbnailPath);
+    if (!file.open(QIODevice::WriteOnly) || !thumbnail.save(&file, "PNG") || !file.commit()) {
+        qWarning() << "Cannot save thumbnail" << thumbnailPath << ":" << file.errorString();
+        return QString();
+    }
+
+    qDebug() << "Created thumbnail of" << path << "in" << lTimer.elapsed() << "ms";
+    return thumbnailPath;
+}
@@ -0,0 +1,49 @@
+#ifndef SERVICES_MEDIA_THUMBNAILER_H
+#define SERVICES_MEDIA_THUMBNAILER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+namespace Services::Media
+{
+/**
+ * Generates small, round-cropped still previews of media files on a worker thread.
+ * Thumbnails are cached on disk, keyed by the content hash of the media file, so they
+ * survive renames and are only regenerated when the content changes.
+ */
+class Thumbnailer : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit Thumbnailer(const QString& directory, QObject* parent = nullptr);
+
+    /**
+     * Queue a thumbnail for the file. The content hash is computed on the worker thread
+     * when it is not passed in.
+     */
+    void generate(const QString& filename, const QString& path, const QByteArray& sha256 = QByteArray());
+    void cancel(const QString& filename);
+
+    /**
+     * Remove the cached thumbnail, e.g. after its media file was deleted.
+     */
+    void remove(const QString& thumbnailPath);
+
+  signals:
+    void thumbnailReady(const QString& filename, const QString& thumbnailPath);
+
+  private:
+    static QString create(const QString& directory, const QString& path, QByteArray sha256);
+
+    QString m_directory;
+    QThreadPool m_pool;
+    QHash<QString, quint64> m_pending; // Filename -> id of the latest request
+    quint64 m_nextId;
+};
+} // namespace Services::Media
+
+#endif // SERVICES_MEDIA_THUMBNAILER_H
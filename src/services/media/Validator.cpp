@@ -0,0 +1,82 @@
+#include "Validator.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QImageReader>
+#include <QtConcurrent>
+
+using namespace Services::Media;
+
+constexpr int VALIDATION_THREADS = 1; // Leave the other cores to rendering
+
+Validator::Validator(QObject* parent)
+    : QObject(parent),
+      m_nextId(0)
+{
+    m_pool.setMaxThreadCount(VALIDATION_THREADS);
+    m_pool.setThreadPriority(QThread::LowPriority);
+}
+
+void Validator::validate(const QString& filename, const QString& path)
+{
+    const quint64 id = ++m_nextId;
+    m_pending.insert(filename, id);
+
+    QtConcurrent::run(&m_pool, &Validator::probe, path).then(this, [this, filename, id](const Validation& validation) {
+        auto it = m_pending.find(filename);
+        if (it == m_pending.end() || it.value() != id) {
+            return; // Cancelled or superseded
+        }
+        m_pending.erase(it);
+
+        emit validated(filename, validation);
+    });
+}
+
+void Validator::cancel(const QString& filename)
+{
+    m_pending.remove(filename);
+}
+
+Validation Validator::probe(const QString& path)
+{
+    QElapsedTimer lTimer;
+    lTimer.start();
+
+    Validation validation;
+
+    QImageReader reader(path);
+    if (!reader.canRead()) {
+        validation.error = reader.errorString();
+        return validation;
+    }
+
+    validation.size = reader.size();
+
+    QImage frame = reader.read();
+    if (frame.isNull()) {
+        validation.error = reader.errorString();
+        return validation;
+    }
+
+    if (!validation.size.isValid()) {
+        validation.size = frame.size();
+    }
+    validation.valid = true;
+    validation.frameCount = 1;
+    validation.duration = qMax(0, reader.nextImageDelay());
+
+    // Decode the remaining frames as well, so a truncated animation shows up here
+    while (reader.supportsAnimation() && reader.canRead()) {
+        frame = reader.read();
+        if (frame.isNull()) {
+            qWarning() << "Media" << path << "is truncated after" << validation.frameCount << "frames:" << reader.errorString();
+            break;
+        }
+
+        ++validation.frameCount;
+        validation.duration += qMax(0, reader.nextImageDelay());
+    }
+
+    qDebug() << "Validated" << path << "(" << validation.frameCount << "frames," << validation.size << ") in" << lTimer.elapsed() << "ms";
+    return validation;
+}
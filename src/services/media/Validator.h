@@ -0,0 +1,53 @@
+#ifndef SERVICES_MEDIA_VALIDATOR_H
+#define SERVICES_MEDIA_VALIDATOR_H
+
+#include <QHash>
+#include <QObject>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+
+namespace Services::Media
+{
+/**
+ * Outcome of decoding a media file: whether it can be shown, and what it contains.
+ */
+struct Validation
+{
+    bool valid = false;
+    int frameCount = 0;
+    QSize size;
+    int duration = 0; // Milliseconds for one loop of an animation, 0 for stills
+    QString error;
+};
+
+/**
+ * Decodes media files on a worker thread, so corrupt files are found before they are shown
+ * instead of stalling the GUI thread during a watchface switch.
+ */
+class Validator : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit Validator(QObject* parent = nullptr);
+
+    /**
+     * Queue the file for validation. A pending validation of the same file is superseded.
+     */
+    void validate(const QString& filename, const QString& path);
+    void cancel(const QString& filename);
+
+    static Validation probe(const QString& path);
+
+  signals:
+    void validated(const QString& filename, const Services::Media::Validation& validation);
+
+  private:
+    QThreadPool m_pool;
+    QHash<QString, quint64> m_pending; // Filename -> id of the latest validation
+    quint64 m_nextId;
+};
+} // namespace Services::Media
+
+#endif // SERVICES_MEDIA_VALIDATOR_H
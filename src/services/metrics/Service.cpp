@@ -0,0 +1,349 @@
+#include "Service.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QQuickWindow>
+#include <QSaveFile>
+#include <QScreen>
+#include <algorithm>
+
+using namespace Services::Metrics;
+
+#ifdef PLATFORM_IS_TARGET
+const QString METRICS_PATH = QStringLiteral("/usr/share/bee/metrics.json");
+#else
+const QString METRICS_PATH = QStringLiteral("/workdir/build/bee/metrics.json");
+#endif
+
+constexpr int MAX_SAMPLES = 600;               // About 10 seconds of continuous animation at 60 Hz
+constexpr int PUBLISH_INTERVAL_MS = 1000;      // Update rate of the debug overlay
+constexpr qint64 IDLE_INTERVAL_NS = 100000000; // Longer gaps between frames mean nothing was animating
+constexpr qreal DEFAULT_REFRESH_RATE = 60.0;
+constexpr qreal NS_PER_MS = 1000000.0;
+
+Service* Service::s_instance = nullptr;
+
+Service::Service(QObject* parent)
+    : QObject(parent),
+      m_collecting(false),
+      m_frameStartNs(-1),
+      m_syncStartNs(0),
+      m_syncNs(0),
+      m_renderStartNs(0),
+      m_renderNs(0),
+      m_lastSwapNs(-1),
+      m_nextSample(0),
+      m_frames(0),
+      m_droppedFrames(0),
+      m_vsyncNs(static_cast<qint64>(1000000000.0 / DEFAULT_REFRESH_RATE)),
+      m_publishedFrames(0),
+      m_publishedDroppedFrames(0),
+      m_frameTimeP50(0),
+      m_frameTimeP90(0),
+      m_frameTimeP99(0),
+      m_frameTimeMax(0),
+      m_syncTimeP50(0),
+      m_syncTimeP99(0),
+      m_renderTimeP50(0),
+      m_renderTimeP99(0)
+{
+    s_instance = this;
+    m_clock.start();
+
+    m_publishTimer.setInterval(PUBLISH_INTERVAL_MS);
+    connect(&m_publishTimer, &QTimer::timeout, this, &Service::publish);
+}
+
+Service::~Service()
+{
+    if (s_instance == this) {
+        s_instance = nullptr;
+    }
+}
+
+Service* Service::instance()
+{
+    return s_instance;
+}
+
+void Service::attach(QQuickWindow* window)
+{
+    m_window = window;
+
+    if (window->screen() && window->screen()->refreshRate() > 0) {
+        QMutexLocker locker(&m_mutex);
+        m_vsyncNs = static_cast<qint64>(1000000000.0 / window->screen()->refreshRate());
+    }
+
+    // Emitted on the render thread with the threaded render loop, the GUI thread is blocked during synchronization
+    connect(window, &QQuickWindow::beforeSynchronizing, this, &Service::onBeforeSynchronizing, Qt::DirectConnection);
+    connect(window, &QQuickWindow::afterSynchronizing, this, &Service::onAfterSynchronizing, Qt::DirectConnection);
+    connect(window, &QQuickWindow::beforeRendering, this, &Service::onBeforeRendering, Qt::DirectConnection);
+    connect(window, &QQuickWindow::afterRendering, this, &Service::onAfterRendering, Qt::DirectConnection);
+    connect(window, &QQuickWindow::frameSwapped, this, &Service::onFrameSwapped, Qt::DirectConnection);
+}
+
+bool Service::collecting() const
+{
+    return m_collecting;
+}
+
+void Service::setCollecting(bool collecting)
+{
+    if (m_collecting == collecting) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_collecting = collecting;
+    }
+
+    if (collecting) {
+        m_publishTimer.start();
+    }
+    else {
+        m_publishTimer.stop();
+        publish();
+    }
+
+    qDebug() << "Render metrics collection" << (collecting ? "started" : "stopped");
+    emit collectingChanged();
+}
+
+quint64 Service::frames() const
+{
+    return m_publishedFrames;
+}
+
+quint64 Service::droppedFrames() const
+{
+    return m_publishedDroppedFrames;
+}
+
+qreal Service::frameTimeP50() const
+{
+    return m_frameTimeP50;
+}
+
+qreal Service::frameTimeP90() const
+{
+    return m_frameTimeP90;
+}
+
+qreal Service::frameTimeP99() const
+{
+    return m_frameTimeP99;
+}
+
+qreal Service::frameTimeMax() const
+{
+    return m_frameTimeMax;
+}
+
+qreal Service::syncTimeP50() const
+{
+    return m_syncTimeP50;
+}
+
+qreal Service::syncTimeP99() const
+{
+    return m_syncTimeP99;
+}
+
+qreal Service::renderTimeP50() const
+{
+    return m_renderTimeP50;
+}
+
+qreal Service::renderTimeP99() const
+{
+    return m_renderTimeP99;
+}
+
+QVariantMap Service::repaints() const
+{
+    return m_publishedRepaints;
+}
+
+void Service::countRepaint(const QString& item)
+{
+    Service* service = s_instance;
+    if (!service) {
+        return;
+    }
+
+    QMutexLocker locker(&service->m_mutex);
+    if (service->m_collecting) {
+        ++service->m_repaints[item];
+    }
+}
+
+void Service::reset()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_samples.clear();
+        m_nextSample = 0;
+        m_frames = 0;
+        m_droppedFrames = 0;
+        m_repaints.clear();
+    }
+    publish();
+}
+
+QString Service::dump() const
+{
+    QDir().mkpath(QFileInfo(METRICS_PATH).absolutePath());
+    QSaveFile file(METRICS_PATH);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write render metrics to" << METRICS_PATH;
+        return QString();
+    }
+
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+    if (!file.commit()) {
+        qWarning() << "Failed to write render metrics to" << METRICS_PATH << ":" << file.errorString();
+        return QString();
+    }
+
+    qInfo() << "Render metrics written to" << METRICS_PATH;
+    return METRICS_PATH;
+}
+
+QJsonObject Service::toJson() const
+{
+    QJsonObject frameTime;
+    frameTime["p50"] = m_frameTimeP50;
+    frameTime["p90"] = m_frameTimeP90;
+    frameTime["p99"] = m_frameTimeP99;
+    frameTime["max"] = m_frameTimeMax;
+
+    QJsonObject syncTime;
+    syncTime["p50"] = m_syncTimeP50;
+    syncTime["p99"] = m_syncTimeP99;
+
+    QJsonObject renderTime;
+    renderTime["p50"] = m_renderTimeP50;
+    renderTime["p99"] = m_renderTimeP99;
+
+    QJsonObject json;
+    json["saved-at"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    json["frames"] = static_cast<double>(m_publishedFrames);
+    json["dropped-frames"] = static_cast<double>(m_publishedDroppedFrames);
+    json["frame-time-ms"] = frameTime;
+    json["sync-time-ms"] = syncTime;
+    json["render-time-ms"] = renderTime;
+    json["repaints"] = QJsonObject::fromVariantMap(m_publishedRepaints);
+    return json;
+}
+
+void Service::onBeforeSynchronizing()
+{
+    m_frameStartNs = m_clock.nsecsElapsed();
+    m_syncStartNs = m_frameStartNs;
+    m_syncNs = 0;
+    m_renderNs = 0;
+}
+
+void Service::onAfterSynchronizing()
+{
+    m_syncNs = m_clock.nsecsElapsed() - m_syncStartNs;
+}
+
+void Service::onBeforeRendering()
+{
+    m_renderStartNs = m_clock.nsecsElapsed();
+}
+
+void Service::onAfterRendering()
+{
+    m_renderNs = m_clock.nsecsElapsed() - m_renderStartNs;
+}
+
+void Service::onFrameSwapped()
+{
+    const qint64 now = m_clock.nsecsElapsed();
+    const qint64 interval = m_lastSwapNs >= 0 ? now - m_lastSwapNs : -1;
+    m_lastSwapNs = now;
+
+    if (m_frameStartNs < 0) {
+        return;
+    }
+    const Sample sample{now - m_frameStartNs, m_syncNs, m_renderNs};
+    m_frameStartNs = -1;
+
+    QMutexLocker locker(&m_mutex);
+    if (!m_collecting) {
+        return;
+    }
+
+    ++m_frames;
+    if (m_samples.size() < MAX_SAMPLES) {
+        m_samples.append(sample);
+    }
+    else {
+        m_samples[m_nextSample] = sample;
+    }
+    m_nextSample = (m_nextSample + 1) % MAX_SAMPLES;
+
+    // Back to back frames that missed one or more vsyncs, longer gaps are idle time rather than drops
+    if (interval > m_vsyncNs * 3 / 2 && interval < IDLE_INTERVAL_NS) {
+        m_droppedFrames += (interval + m_vsyncNs / 2) / m_vsyncNs - 1;
+    }
+}
+
+void Service::publish()
+{
+    QList<qint64> frameTimes;
+    QList<qint64> syncTimes;
+    QList<qint64> renderTimes;
+    QHash<QString, quint64> repaints;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        frameTimes.reserve(m_samples.size());
+        syncTimes.reserve(m_samples.size());
+        renderTimes.reserve(m_samples.size());
+        for (const Sample& sample : std::as_const(m_samples)) {
+            frameTimes.append(sample.frameNs);
+            syncTimes.append(sample.syncNs);
+            renderTimes.append(sample.renderNs);
+        }
+        m_publishedFrames = m_frames;
+        m_publishedDroppedFrames = m_droppedFrames;
+        repaints = m_repaints;
+    }
+
+    m_frameTimeP50 = percentile(frameTimes, 0.5);
+    m_frameTimeP90 = percentile(frameTimes, 0.9);
+    m_frameTimeP99 = percentile(frameTimes, 0.99);
+    m_frameTimeMax = percentile(frameTimes, 1.0);
+    m_syncTimeP50 = percentile(syncTimes, 0.5);
+    m_syncTimeP99 = percentile(syncTimes, 0.99);
+    m_renderTimeP50 = percentile(renderTimes, 0.5);
+    m_renderTimeP99 = percentile(renderTimes, 0.99);
+
+    m_publishedRepaints.clear();
+    for (auto it = repaints.cbegin(); it != repaints.cend(); ++it) {
+        m_publishedRepaints.insert(it.key(), static_cast<double>(it.value()));
+    }
+
+    emit metricsChanged();
+}
+
+qreal Service::percentile(QList<qint64> values, qreal fraction)
+{
+    if (values.isEmpty()) {
+        return 0;
+    }
+
+    // Nearest rank, in milliseconds
+    const qsizetype rank = std::clamp<qsizetype>(static_cast<qsizetype>(fraction * values.size() + 0.5) - 1, 0, values.size() - 1);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values.at(rank) / NS_PER_MS;
+}
@@ -0,0 +1,138 @@
+#ifndef SERVICES_METRICS_SERVICE_H
+#define SERVICES_METRICS_SERVICE_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QVariantMap>
+
+class QQuickWindow;
+
+namespace Services::Metrics
+{
+/**
+ * Service
+ *
+ * Render loop instrumentation of the main window: frame, scene graph sync and render times,
+ * dropped frames and repaint counts of custom items. Samples are taken on the render thread
+ * while collecting is enabled and published once per second.
+ */
+class Service : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool collecting READ collecting WRITE setCollecting NOTIFY collectingChanged)
+    Q_PROPERTY(quint64 frames READ frames NOTIFY metricsChanged)
+    Q_PROPERTY(quint64 droppedFrames READ droppedFrames NOTIFY metricsChanged)
+    Q_PROPERTY(qreal frameTimeP50 READ frameTimeP50 NOTIFY metricsChanged)
+    Q_PROPERTY(qreal frameTimeP90 READ frameTimeP90 NOTIFY metricsChanged)
+    Q_PROPERTY(qreal frameTimeP99 READ frameTimeP99 NOTIFY metricsChanged)
+    Q_PROPERTY(qreal frameTimeMax READ frameTimeMax NOTIFY metricsChanged)
+    Q_PROPERTY(qreal syncTimeP50 READ syncTimeP50 NOTIFY metricsChanged)
+    Q_PROPERTY(qreal syncTimeP99 READ syncTimeP99 NOTIFY metricsChanged)
+    Q_PROPERTY(qreal renderTimeP50 READ renderTimeP50 NOTIFY metricsChanged)
+    Q_PROPERTY(qreal renderTimeP99 READ renderTimeP99 NOTIFY metricsChanged)
+    Q_PROPERTY(QVariantMap repaints READ repaints NOTIFY metricsChanged)
+
+  public:
+    explicit Service(QObject* parent = nullptr);
+    ~Service() override;
+
+    static Service* instance();
+
+    void attach(QQuickWindow* window);
+
+    bool collecting() const;
+    void setCollecting(bool collecting);
+
+    quint64 frames() const;
+    quint64 droppedFrames() const;
+    qreal frameTimeP50() const;
+    qreal frameTimeP90() const;
+    qreal frameTimeP99() const;
+    qreal frameTimeMax() const;
+    qreal syncTimeP50() const;
+    qreal syncTimeP99() const;
+    qreal renderTimeP50() const;
+    qreal renderTimeP99() const;
+    QVariantMap repaints() const;
+
+    /**
+     * Counts a repaint of a custom item, callable from the render thread (e.g. from updatePaintNode()).
+     */
+    static void countRepaint(const QString& item);
+
+    Q_INVOKABLE void reset();
+
+    /**
+     * Writes the current metrics as JSON, for comparing builds. Returns the path written, empty on failure.
+     */
+    Q_INVOKABLE QString dump() const;
+    QJsonObject toJson() const;
+
+  signals:
+    void collectingChanged();
+    void metricsChanged();
+
+  private:
+    struct Sample
+    {
+        qint64 frameNs;
+        qint64 syncNs;
+        qint64 renderNs;
+    };
+
+    // Render thread
+    void onBeforeSynchronizing();
+    void onAfterSynchronizing();
+    void onBeforeRendering();
+    void onAfterRendering();
+    void onFrameSwapped();
+
+    void publish();
+    static qreal percentile(QList<qint64> values, qreal fraction);
+
+    static Service* s_instance;
+
+    QPointer<QQuickWindow> m_window;
+    QTimer m_publishTimer;
+    QElapsedTimer m_clock;
+    bool m_collecting;
+
+    // Written on the render thread only
+    qint64 m_frameStartNs;
+    qint64 m_syncStartNs;
+    qint64 m_syncNs;
+    qint64 m_renderStartNs;
+    qint64 m_renderNs;
+    qint64 m_lastSwapNs;
+
+    // Shared between the render thread and the GUI thread
+    mutable QMutex m_mutex;
+    QList<Sample> m_samples; // Ring buffer of the latest frames
+    int m_nextSample;
+    quint64 m_frames;
+    quint64 m_droppedFrames;
+    qint64 m_vsyncNs;
+    QHash<QString, quint64> m_repaints;
+
+    // Published on the GUI thread
+    quint64 m_publishedFrames;
+    quint64 m_publishedDroppedFrames;
+    qreal m_frameTimeP50;
+    qreal m_frameTimeP90;
+    qreal m_frameTimeP99;
+    qreal m_frameTimeMax;
+    qreal m_syncTimeP50;
+    qreal m_syncTimeP99;
+    qreal m_renderTimeP50;
+    qreal m_renderTimeP99;
+    QVariantMap m_publishedRepaints;
+};
+} // namespace Services::Metrics
+
+#endif // SERVICES_METRICS_SERVICE_H
@@ -15,12 +15,16 @@ void Service::registerObject(const char* name, QObject* object)
         return;
     }
 
-    QElapsedTimer lTimer;
-    lTimer.start();
+    Tracing::BootTrace::Span span(name, "qml");
     object->setObjectName(name);
     if (!m_registeredObjectsNames.contains(name)) {
         qmlRegisterSingletonInstance("Bee", 1, 0, name, object);
         m_registeredObjectsNames.append(name);
-        qDebug() << "Registered QML interface:" << name << "in" << lTimer.elapsed() << "ms";
+        qDebug() << "Registered QML interface:" << name;
     }
 }
+
+void Service::traceInstant(const QString& name)
+{
+    Tracing::BootTrace::instant(name, "qml");
+}
@@ -1,10 +1,11 @@
 #ifndef SERVICES_QMLINTERFACE_SERVICE_H
 #define SERVICES_QMLINTERFACE_SERVICE_H
 
-#include <QElapsedTimer>
 #include <QObject>
 #include <QQmlApplicationEngine>
 
+#include "tracing/BootTrace.h"
+
 namespace Services::QmlInterface
 {
 class Service : public QObject
@@ -16,19 +17,22 @@ class Service : public QObject
     Service(QObject* parent = nullptr);
 
     void registerObject(const char* name, QObject* object);
+
+    /**
+     * Boot trace marker from QML, e.g. when lazily loaded content is ready.
+     */
+    Q_INVOKABLE void traceInstant(const QString& name);
     template <typename T>
     void registerType(const char* name)
     {
-        QElapsedTimer lTimer;
-        lTimer.start();
+        Tracing::BootTrace::Span span(name, "qml");
         qmlRegisterType<T>("Bee", 1, 0, name);
-        qDebug() << "Registered QML type:" << name << "in" << lTimer.elapsed() << "ms";
+        qDebug() << "Registered QML type:" << name;
     }
     template <typename T>
     void registerUncreatableType(const char* name)
     {
-        QElapsedTimer lTimer;
-        lTimer.start();
+        Tracing::BootTrace::Span span(name, "qml");
         qmlRegisterUncreatableMetaObject(
             T::staticMetaObject,
             "Bee",
@@ -36,7 +40,7 @@ class Service : public QObject
             0,
             name,
             QString("Cannot create %1").arg(name));
-        qDebug() << "Registered QML type:" << name << "in" << lTimer.elapsed() << "ms";
+        qDebug() << "Registered QML type:" << name;
     }
 
   private:
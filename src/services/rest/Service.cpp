@@ -2,8 +2,13 @@
 #include "drivers/network/Driver.h"
 
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QSet>
 #include <QSettings>
 #include <QTimer>
+#include <cstdio>
 
 using namespace Services::Rest;
 
@@ -11,6 +16,11 @@ constexpr int NETWORK_TIMEOUT_MS = 30 * 1000; // 30 seconds
 const QString PROPERTIES_GROUP_NAME = QStringLiteral("rest-api");
 const QString PROPERTY_SERVER_URL_KEY = QStringLiteral("url");
 const QString PROPERTY_SERVER_URL_DEFAULT = QStringLiteral("http://127.0.0.1:5000");
+const QString PARTIAL_DOWNLOAD_SUFFIX = QStringLiteral(".part");
+const QString PARTIAL_VALIDATOR_SUFFIX = QStringLiteral(".part.validator"); // ETag or Last-Modified of the partial file
+constexpr int HTTP_STATUS_PARTIAL_CONTENT = 206;
+constexpr int HTTP_STATUS_BAD_REQUEST = 400;
+constexpr int HTTP_STATUS_RANGE_NOT_SATISFIABLE = 416;
 
 Service::Service(Drivers::Network::Driver& network, QObject* parent)
     : QObject(parent),
@@ -152,6 +162,70 @@ void Service::download(const QString& endpoint, DataCallback callback)
     });
 }
 
+QNetworkReply* Service::downloadToFile(const QString& endpoint, const QString& filePath, FileCallback callback, ProgressCallback progress)
+{
+    if (!m_network.loopbackInterfaceConnected()) {
+        qWarning() << "REST: Network not connected, cannot download" << endpoint;
+        if (callback) QTimer::singleShot(0, this, [callback]() { callback(false, QString(), "Network not connected"); });
+        return nullptr;
+    }
+
+    // Append mode keeps the bytes of an earlier, interrupted attempt
+    auto file = QSharedPointer<QFile>::create(filePath + PARTIAL_DOWNLOAD_SUFFIX);
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Append)) {
+        QString error = "Cannot open " + file->fileName() + ": " + file->errorString();
+        qWarning() << "REST:" << error;
+        if (callback) QTimer::singleShot(0, this, [callback, error]() { callback(false, QString(), error); });
+        return nullptr;
+    }
+
+    // Without a validator there is no way to tell whether the resource changed since, so start over
+    const QByteArray validator = readPartialValidator(filePath);
+    if (file->size() > 0 && validator.isEmpty()) {
+        qDebug() << "REST: No validator for the partial download of" << endpoint << ", restarting";
+        file->resize(0);
+    }
+
+    const qint64 resumeOffset = file->size();
+
+    QNetworkRequest request = createRequest(endpoint);
+    if (resumeOffset > 0) {
+        // If-Range makes the server send the whole resource again when it changed
+        qDebug() << "REST: Resuming download of" << endpoint << "at byte" << resumeOffset;
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(resumeOffset) + "-");
+        request.setRawHeader("If-Range", validator);
+    }
+    QNetworkReply* reply = m_networkManager.get(request);
+
+    PendingRequest pending;
+    pending.reply = reply;
+    pending.fileCallback = callback;
+    pending.progressCallback = progress;
+    pending.file = file;
+    pending.filePath = filePath;
+    pending.resumeOffset = resumeOffset;
+    pending.validator = validator;
+    pending.isFileDownload = true;
+    m_pendingRequests[reply] = pending;
+
+    connect(reply, &QNetworkReply::readyRead, this, [this, reply]() {
+        handleFileData(reply);
+    });
+    connect(reply, &QNetworkReply::downloadProgress, this, [this, reply](qint64 bytesReceived, qint64 bytesTotal) {
+        auto it = m_pendingRequests.find(reply);
+        if (it == m_pendingRequests.end() || !it->progressCallback) return;
+
+        // Report progress of the whole file, including what was already on disk
+        qint64 offset = it->resumeOffset;
+        it->progressCallback(offset + bytesReceived, bytesTotal < 0 ? -1 : offset + bytesTotal);
+    });
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        handleResponse(reply);
+    });
+
+    return reply;
+}
+
 void Service::loadProperties()
 {
     QSettings settings;
@@ -184,10 +258,21 @@ QNetworkRequest Service::createRequest(const QString& endpoint)
 void Service::handleResponse(QNetworkReply* reply)
 {
     reply->deleteLater();
-    if (!m_pendingRequests.contains(reply)) return;
+    auto it = m_pendingRequests.find(reply);
+    if (it == m_pendingRequests.end()) return;
+
+    // Store whatever arrived after the last readyRead before the entry is removed
+    if (it->isFileDownload && reply->error() == QNetworkReply::NoError) {
+        handleFileData(reply);
+    }
 
     PendingRequest pending = m_pendingRequests.take(reply);
 
+    if (pending.isFileDownload) {
+        finishFileDownload(reply, pending);
+        return;
+    }
+
     if (reply->error() != QNetworkReply::NoError) {
         handleError(reply, reply->errorString());
         // Propagate error via callback
@@ -220,6 +305,142 @@ void Service::handleResponse(QNetworkReply* reply)
     }
 }
 
+void Service::handleFileData(QNetworkReply* reply)
+{
+    auto it = m_pendingRequests.find(reply);
+    if (it == m_pendingRequests.end() || it->discardPartial) return;
+
+    // Error pages are not part of the resource and must not end up in the partial file
+    int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status >= HTTP_STATUS_BAD_REQUEST) {
+        reply->readAll();
+        return;
+    }
+
+    if (!it->statusChecked) {
+        it->statusChecked = true;
+        const QByteArray validator = responseValidator(reply);
+
+        if (it->resumeOffset > 0 && status == HTTP_STATUS_PARTIAL_CONTENT && validator != it->validator) {
+            // A server ignoring If-Range would append bytes of a different version to the old ones
+            qWarning() << "REST: Resource changed during resumed download, discarding" << it->file->fileName();
+            it->discardPartial = true;
+            reply->abort();
+            return;
+        }
+
+        // The resource changed, or the server ignores the Range header, and sends the whole file again
+        if (it->resumeOffset > 0 && status != HTTP_STATUS_PARTIAL_CONTENT) {
+            qDebug() << "REST: Server sent the whole resource, restarting" << it->filePath;
+            it->file->resize(0);
+            it->resumeOffset = 0;
+        }
+
+        if (it->resumeOffset == 0) {
+            writePartialValidator(it->filePath, validator);
+        }
+    }
+
+    if (it->file->write(reply->readAll()) < 0) {
+        qWarning() << "REST: Failed to write" << it->file->fileName() << ":" << it->file->errorString();
+        reply->abort();
+    }
+}
+
+void Service::finishFileDownload(QNetworkReply* reply, PendingRequest& pending)
+{
+    QString writeError;
+    if (!pending.file->flush() || pending.file->error() != QFileDevice::NoError) {
+        writeError = "Failed to write " + pending.file->fileName() + ": " + pending.file->errorString();
+    }
+    pending.file->close();
+
+    if (pending.discardPartial) {
+        removePartialDownload(pending.filePath);
+        if (pending.fileCallback) pending.fileCallback(false, QString(), "Resource changed during resumed download");
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError) {
+        handleError(reply, reply->errorString());
+
+        // Remove the partial file when it no longer matches the resource, or when nothing was received at all
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (status == HTTP_STATUS_RANGE_NOT_SATISFIABLE || pending.file->size() == 0) {
+            removePartialDownload(pending.filePath);
+        }
+
+        if (pending.fileCallback) pending.fileCallback(false, QString(), reply->errorString());
+        return;
+    }
+
+    if (!writeError.isEmpty()) {
+        qWarning() << "REST:" << writeError;
+        if (pending.fileCallback) pending.fileCallback(false, QString(), writeError);
+        return;
+    }
+
+    // rename() replaces an existing file atomically, so readers never see a half written file
+    if (std::rename(QFile::encodeName(pending.file->fileName()).constData(), QFile::encodeName(pending.filePath).constData()) != 0) {
+        QString error = "Failed to move " + pending.file->fileName() + " to " + pending.filePath;
+        qWarning() << "REST:" << error;
+        if (pending.fileCallback) pending.fileCallback(false, QString(), error);
+        return;
+    }
+
+    QFile::remove(pending.filePath + PARTIAL_VALIDATOR_SUFFIX);
+    if (pending.fileCallback) pending.fileCallback(true, pending.filePath, QString());
+}
+
+void Service::removePartialDownload(const QString& filePath)
+{
+    QFile::remove(filePath + PARTIAL_DOWNLOAD_SUFFIX);
+    QFile::remove(filePath + PARTIAL_VALIDATOR_SUFFIX);
+}
+
+QStringList Service::partialDownloads(const QString& directory)
+{
+    QSet<QString> filenames;
+    const QStringList entries = QDir(directory).entryList({"*" + PARTIAL_DOWNLOAD_SUFFIX, "*" + PARTIAL_VALIDATOR_SUFFIX}, QDir::Files);
+    for (const QString& entry : entries) {
+        const QString& suffix = entry.endsWith(PARTIAL_VALIDATOR_SUFFIX) ? PARTIAL_VALIDATOR_SUFFIX : PARTIAL_DOWNLOAD_SUFFIX;
+        filenames.insert(entry.chopped(suffix.size()));
+    }
+    return QStringList(filenames.cbegin(), filenames.cend());
+}
+
+QByteArray Service::responseValidator(QNetworkReply* reply)
+{
+    // Weak ETags cannot be used in If-Range, fall back to the modification date
+    const QByteArray etag = reply->rawHeader("ETag");
+    if (!etag.isEmpty() && !etag.startsWith("W/")) {
+        return etag;
+    }
+    return reply->rawHeader("Last-Modified");
+}
+
+QByteArray Service::readPartialValidator(const QString& filePath)
+{
+    QFile file(filePath + PARTIAL_VALIDATOR_SUFFIX);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll().trimmed();
+}
+
+void Service::writePartialValidator(const QString& filePath, const QByteArray& validator)
+{
+    if (validator.isEmpty()) {
+        QFile::remove(filePath + PARTIAL_VALIDATOR_SUFFIX);
+        return;
+    }
+
+    QSaveFile file(filePath + PARTIAL_VALIDATOR_SUFFIX);
+    if (!file.open(QIODevice::WriteOnly) || file.write(validator) < 0 || !file.commit()) {
+        qWarning() << "REST: Failed to store the validator of" << filePath << ":" << file.errorString();
+    }
+}
+
 void Service::handleError(QNetworkReply* reply, const QString& errorString)
 {
     qWarning() << "REST Error:" << errorString << "URL:" << reply->url().toString();
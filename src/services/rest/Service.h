@@ -6,8 +6,12 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QObject>
+#include <QSharedPointer>
+#include <QStringList>
 #include <functional>
 
+class QFile;
+
 namespace Drivers::Network
 {
 class Driver;
@@ -31,6 +35,8 @@ class Service : public QObject
     // Callbacks
     using ResponseCallback = std::function<void(bool success, const QJsonObject& response, const QString& error)>;
     using DataCallback = std::function<void(bool success, const QByteArray& data, const QString& error)>;
+    using FileCallback = std::function<void(bool success, const QString& filePath, const QString& error)>;
+    using ProgressCallback = std::function<void(qint64 bytesReceived, qint64 bytesTotal)>;
 
     // HTTP Methods
     void get(const QString& endpoint, ResponseCallback callback);
@@ -39,6 +45,20 @@ class Service : public QObject
     void deleteResource(const QString& endpoint, ResponseCallback callback);
     void download(const QString& endpoint, DataCallback callback);
 
+    /**
+     * Stream a resource straight to disk. Data is appended to "<filePath>.part" as it arrives
+     * and the partial file is atomically renamed to filePath once the transfer completes.
+     * A partial file left behind by an earlier attempt is resumed with an HTTP Range request, guarded by
+     * If-Range with the ETag or Last-Modified stored next to it, so a changed resource is downloaded again.
+     * Returns the reply so callers can abort it, or nullptr when the download could not start.
+     */
+    QNetworkReply* downloadToFile(const QString& endpoint, const QString& filePath, FileCallback callback, ProgressCallback progress = nullptr);
+
+    // Removes what an interrupted downloadToFile() left behind for filePath
+    static void removePartialDownload(const QString& filePath);
+    // Names of the files in directory that have an interrupted downloadToFile() left behind
+    static QStringList partialDownloads(const QString& directory);
+
   signals:
     void serverUrlChanged();
 
@@ -48,14 +68,28 @@ class Service : public QObject
         QNetworkReply* reply;
         ResponseCallback responseCallback;
         DataCallback dataCallback;
-        bool isBinaryDownload;
+        FileCallback fileCallback;
+        ProgressCallback progressCallback;
+        QSharedPointer<QFile> file;
+        QString filePath;
+        QByteArray validator; // Sent in If-Range when resuming
+        qint64 resumeOffset = 0;
+        bool statusChecked = false;
+        bool discardPartial = false;
+        bool isBinaryDownload = false;
+        bool isFileDownload = false;
     };
 
     void loadProperties();
     void saveProperty(const QString& key, const QVariant& value);
     QNetworkRequest createRequest(const QString& endpoint);
     void handleResponse(QNetworkReply* reply);
+    void handleFileData(QNetworkReply* reply);
+    void finishFileDownload(QNetworkReply* reply, PendingRequest& pending);
     void handleError(QNetworkReply* reply, const QString& errorString);
+    static QByteArray responseValidator(QNetworkReply* reply);
+    static QByteArray readPartialValidator(const QString& filePath);
+    static void writePartialValidator(const QString& filePath, const QByteArray& validator);
 
     Drivers::Network::Driver& m_network;
     QNetworkAccessManager m_networkManager;
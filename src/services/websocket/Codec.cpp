@@ -0,0 +1,37 @@
+#include "Codec.h"
+#include <QCborMap>
+#include <QCborValue>
+#include <QJsonDocument>
+
+using namespace Services::WebSocket;
+
+QByteArray Codec::encode(const QJsonObject& message, Encoding encoding)
+{
+    if (encoding == Encoding::Cbor) {
+        return QCborValue::fromJsonValue(message).toCbor();
+    }
+    return QJsonDocument(message).toJson(QJsonDocument::Compact);
+}
+
+bool Codec::decode(const QByteArray& frame, Encoding encoding, QJsonObject& message, QString& error)
+{
+    if (encoding == Encoding::Cbor) {
+        QCborParserError cborError;
+        const QCborValue value = QCborValue::fromCbor(frame, &cborError);
+        if (cborError.error != QCborError::NoError || !value.isMap()) {
+            error = cborError.error != QCborError::NoError ? cborError.errorString() : QStringLiteral("not a map");
+            return false;
+        }
+        message = value.toMap().toJsonObject();
+        return true;
+    }
+
+    QJsonParseError jsonError;
+    const QJsonDocument document = QJsonDocument::fromJson(frame, &jsonError);
+    if (!document.isObject()) {
+        error = jsonError.error != QJsonParseError::NoError ? jsonError.errorString() : QStringLiteral("not an object");
+        return false;
+    }
+    message = document.object();
+    return true;
+}
@@ -0,0 +1,28 @@
+#ifndef SERVICES_WEBSOCKET_CODEC_H
+#define SERVICES_WEBSOCKET_CODEC_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+#include "Types.h"
+
+namespace Services::WebSocket
+{
+/**
+ * Frame payloads of the JSON-RPC messages for each negotiated encoding. Text frames carry the
+ * same UTF-8 JSON as binary JSON frames; the socket converts them to and from UTF-16.
+ */
+class Codec
+{
+  public:
+    static QByteArray encode(const QJsonObject& message, Encoding encoding);
+
+    /**
+     * Decode a frame into message, false with a reason in error when it is not a valid message.
+     */
+    static bool decode(const QByteArray& frame, Encoding encoding, QJsonObject& message, QString& error);
+};
+} // namespace Services::WebSocket
+
+#endif // SERVICES_WEBSOCKET_CODEC_H
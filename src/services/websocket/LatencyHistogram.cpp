@@ -0,0 +1,86 @@
+#include "LatencyHistogram.h"
+#include <QVariantList>
+#include <cmath>
+
+using namespace Services::WebSocket;
+
+void LatencyHistogram::add(qint64 latencyMs)
+{
+    size_t bucket = 0;
+    while (bucket < BUCKET_BOUNDS_MS.size() && latencyMs > BUCKET_BOUNDS_MS[bucket]) {
+        ++bucket;
+    }
+
+    ++m_buckets[bucket];
+    ++m_count;
+    m_total += latencyMs;
+    m_max = qMax(m_max, latencyMs);
+}
+
+void LatencyHistogram::addTimeout()
+{
+    ++m_timeouts;
+}
+
+quint64 LatencyHistogram::count() const
+{
+    return m_count;
+}
+
+quint64 LatencyHistogram::timeouts() const
+{
+    return m_timeouts;
+}
+
+qint64 LatencyHistogram::max() const
+{
+    return m_max;
+}
+
+qint64 LatencyHistogram::average() const
+{
+    return m_count > 0 ? m_total / static_cast<qint64>(m_count) : 0;
+}
+
+qint64 LatencyHistogram::percentile(qreal fraction) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    const quint64 rank = static_cast<quint64>(std::ceil(fraction * m_count));
+    quint64 seen = 0;
+    for (size_t bucket = 0; bucket < BUCKET_BOUNDS_MS.size(); ++bucket) {
+        seen += m_buckets[bucket];
+        if (seen >= rank) {
+            return qMin<qint64>(BUCKET_BOUNDS_MS[bucket], m_max);
+        }
+    }
+
+    return m_max;
+}
+
+QVariantMap LatencyHistogram::toVariantMap() const
+{
+    QVariantList buckets;
+    for (quint64 bucket : m_buckets) {
+        buckets.append(bucket);
+    }
+
+    QVariantList bounds;
+    for (int bound : BUCKET_BOUNDS_MS) {
+        bounds.append(bound);
+    }
+
+    QVariantMap map;
+    map["count"] = m_count;
+    map["timeouts"] = m_timeouts;
+    map["average"] = average();
+    map["p50"] = percentile(0.50);
+    map["p95"] = percentile(0.95);
+    map["p99"] = percentile(0.99);
+    map["max"] = m_max;
+    map["bounds"] = bounds;
+    map["buckets"] = buckets;
+    return map;
+}
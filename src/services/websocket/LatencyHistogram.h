@@ -0,0 +1,38 @@
+#ifndef SERVICES_WEBSOCKET_LATENCYHISTOGRAM_H
+#define SERVICES_WEBSOCKET_LATENCYHISTOGRAM_H
+
+#include <QVariantMap>
+#include <array>
+
+namespace Services::WebSocket
+{
+/**
+ * Fixed-bucket histogram of request round-trip times. Constant memory and O(1) per sample,
+ * percentiles are resolved to the upper bound of the bucket they fall in.
+ */
+class LatencyHistogram
+{
+  public:
+    static constexpr std::array<int, 10> BUCKET_BOUNDS_MS = {10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000};
+
+    void add(qint64 latencyMs);
+    void addTimeout();
+
+    quint64 count() const;
+    quint64 timeouts() const;
+    qint64 max() const;
+    qint64 average() const;
+    qint64 percentile(qreal fraction) const;
+
+    QVariantMap toVariantMap() const;
+
+  private:
+    std::array<quint64, BUCKET_BOUNDS_MS.size() + 1> m_buckets = {}; // Last bucket collects everything above the bounds
+    quint64 m_count = 0;
+    quint64 m_timeouts = 0;
+    qint64 m_total = 0;
+    qint64 m_max = 0;
+};
+} // namespace Services::WebSocket
+
+#endif // SERVICES_WEBSOCKET_LATENCYHISTOGRAM_H
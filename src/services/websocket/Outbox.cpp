@@ -0,0 +1,136 @@
+#include "Outbox.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+using namespace Services::WebSocket;
+
+constexpr int OUTBOX_MAX_ENTRIES = 16;
+constexpr qint64 OUTBOX_MAX_AGE_SECONDS = 24 * 60 * 60; // Older publishes are no longer relevant
+constexpr int SAVE_INTERVAL_MS = 5000;                  // Batches queued publishes, the storage is flash
+
+Outbox::Outbox(const QString& filePath)
+    : m_filePath(filePath)
+{
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(SAVE_INTERVAL_MS);
+    QObject::connect(&m_saveTimer, &QTimer::timeout, &m_saveTimer, [this]() {
+        save();
+    });
+}
+
+Outbox::~Outbox()
+{
+    // Publishes queued since the last batch survive a regular shutdown
+    if (m_saveTimer.isActive()) {
+        save();
+    }
+}
+
+void Outbox::load()
+{
+    m_entries.clear();
+
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonArray entries = QJsonDocument::fromJson(file.readAll()).array();
+    for (const auto& value : entries) {
+        QJsonObject object = value.toObject();
+        Topic topic = topicFromString(object["topic"].toString());
+        if (topic == Topic::Unknown) {
+            continue;
+        }
+
+        m_entries.append(Entry{topic, object["params"].toObject(), QDateTime::fromString(object["queuedAt"].toString(), Qt::ISODate)});
+    }
+
+    dropExpired();
+    qDebug() << "Loaded" << m_entries.size() << "unsent publishes from" << m_filePath;
+}
+
+void Outbox::put(Topic topic, const QJsonObject& params)
+{
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries.at(i).topic == topic) {
+            m_entries.removeAt(i);
+            break;
+        }
+    }
+
+    m_entries.append(Entry{topic, params, QDateTime::currentDateTimeUtc()});
+    while (m_entries.size() > OUTBOX_MAX_ENTRIES) {
+        m_entries.removeFirst();
+    }
+
+    if (!m_saveTimer.isActive()) {
+        m_saveTimer.start();
+    }
+}
+
+QList<Outbox::Entry> Outbox::takeAll()
+{
+    dropExpired();
+
+    QList<Entry> entries;
+    entries.swap(m_entries);
+    if (!entries.isEmpty()) {
+        save();
+    }
+    return entries;
+}
+
+int Outbox::size() const
+{
+    return m_entries.size();
+}
+
+bool Outbox::isEmpty() const
+{
+    return m_entries.isEmpty();
+}
+
+void Outbox::save()
+{
+    m_saveTimer.stop();
+
+    if (m_entries.isEmpty()) {
+        QFile::remove(m_filePath);
+        return;
+    }
+
+    QJsonArray entries;
+    for (const Entry& entry : m_entries) {
+        QJsonObject object;
+        object["topic"] = topicToString(entry.topic);
+        object["params"] = entry.params;
+        object["queuedAt"] = entry.queuedAt.toString(Qt::ISODate);
+        entries.append(object);
+    }
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to save outbox to" << m_filePath;
+        return;
+    }
+
+    file.write(QJsonDocument(entries).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "Failed to save outbox to" << m_filePath << ":" << file.errorString();
+    }
+}
+
+void Outbox::dropExpired()
+{
+    const QDateTime oldest = QDateTime::currentDateTimeUtc().addSecs(-OUTBOX_MAX_AGE_SECONDS);
+    m_entries.removeIf([&oldest](const Entry& entry) {
+        return !entry.queuedAt.isValid() || entry.queuedAt < oldest;
+    });
+}
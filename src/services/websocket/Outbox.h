@@ -0,0 +1,58 @@
+#ifndef SERVICES_WEBSOCKET_OUTBOX_H
+#define SERVICES_WEBSOCKET_OUTBOX_H
+
+#include <QDateTime>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QTimer>
+
+#include "Types.h"
+
+namespace Services::WebSocket
+{
+/**
+ * Publishes that could not be sent while disconnected. Only the latest message per topic
+ * is kept (a newer status supersedes an older one), the number of entries is bounded and
+ * the outbox is persisted, so it survives a restart during an outage. Queued publishes are
+ * written in batches, not one flash write per message.
+ */
+class Outbox
+{
+  public:
+    struct Entry
+    {
+        Topic topic;
+        QJsonObject params;
+        QDateTime queuedAt;
+    };
+
+    explicit Outbox(const QString& filePath);
+    ~Outbox();
+
+    void load();
+
+    /**
+     * Queue a publish, replacing a queued publish to the same topic.
+     */
+    void put(Topic topic, const QJsonObject& params);
+
+    /**
+     * Remove and return all entries that are not too old to be sent, oldest first.
+     */
+    QList<Entry> takeAll();
+
+    int size() const;
+    bool isEmpty() const;
+
+  private:
+    void save();
+    void dropExpired();
+
+    QString m_filePath;
+    QList<Entry> m_entries;
+    QTimer m_saveTimer;
+};
+} // namespace Services::WebSocket
+
+#endif // SERVICES_WEBSOCKET_OUTBOX_H
@@ -1,16 +1,42 @@
 #include "Service.h"
+#include "Codec.h"
 #include "drivers/network/Driver.h"
 
 #include <QDebug>
+#include <QLoggingCategory>
+#include <QRandomGenerator>
 #include <QSettings>
 #include <QTimer>
+#include <QWebSocketHandshakeOptions>
+#include <limits>
 
 using namespace Services::WebSocket;
 
+// Enable with QT_LOGGING_RULES="bee.websocket.debug=true;bee.websocket.payload.debug=true"
+Q_LOGGING_CATEGORY(lcWebSocket, "bee.websocket", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcWebSocketPayload, "bee.websocket.payload", QtInfoMsg)
+
 const QString PROPERTIES_GROUP_NAME = QStringLiteral("websocket-api");
 const QString PROPERTY_SERVER_URL_KEY = QStringLiteral("url");
 const QString PROPERTY_SERVER_URL_DEFAULT = QStringLiteral("ws://127.0.0.1:5000/ws");
-constexpr int RECONNECT_INTERVAL_MS = 5000;
+const QString PROPERTY_BINARY_KEY = QStringLiteral("binary");
+constexpr bool PROPERTY_BINARY_DEFAULT = true;
+const QString PROPERTY_MAX_REQUESTS_IN_FLIGHT_KEY = QStringLiteral("max-requests-in-flight");
+constexpr int PROPERTY_MAX_REQUESTS_IN_FLIGHT_DEFAULT = 4;
+const QString PROPERTY_REQUEST_TIMEOUT_KEY = QStringLiteral("request-timeout");
+constexpr int PROPERTY_REQUEST_TIMEOUT_DEFAULT = 8000; // Milliseconds, below the 10 s startup check of the services
+constexpr int MAX_QUEUED_REQUESTS = 64;                // Beyond this the backend is not keeping up, new requests fail
+constexpr int RECONNECT_BASE_DELAY_MS = 1000;  // Doubled for every failed attempt
+constexpr int RECONNECT_MAX_DELAY_MS = 60000;  // 1 minute
+#ifdef PLATFORM_IS_TARGET
+const QString OUTBOX_PATH = QStringLiteral("/usr/share/bee/websocket-outbox.json");
+#else
+const QString OUTBOX_PATH = QStringLiteral("/workdir/build/bee/websocket-outbox.json");
+#endif
+// Offered during the handshake, most preferred first. A server that picks none gets text frames.
+const QString SUBPROTOCOL_CBOR = QStringLiteral("bee.cbor.v1");
+const QString SUBPROTOCOL_JSON = QStringLiteral("bee.json.v1");
+constexpr int PAYLOAD_LOG_LIMIT = 512; // Characters of a payload that make it into the log
 
 Service::Service(Drivers::Network::Driver& network, QObject* parent)
     : QObject(parent),
@@ -18,14 +44,32 @@ Service::Service(Drivers::Network::Driver& network, QObject* parent)
       m_webSocket(QString(), QWebSocketProtocol::VersionLatest, this),
       m_serverUrl(PROPERTY_SERVER_URL_DEFAULT),
       m_connected(false),
-      m_nextRequestId(1)
+      m_binaryEnabled(PROPERTY_BINARY_DEFAULT),
+      m_encoding(Encoding::Text),
+      m_nextRequestId(1),
+      m_maxRequestsInFlight(PROPERTY_MAX_REQUESTS_IN_FLIGHT_DEFAULT),
+      m_requestTimeoutMs(PROPERTY_REQUEST_TIMEOUT_DEFAULT),
+      m_expiryTimer(this),
+      m_outbox(OUTBOX_PATH),
+      m_reconnectTimer(this),
+      m_reconnectAttempts(0)
 {
     loadProperties();
+    m_countersTimer.start();
+
+    m_expiryTimer.setSingleShot(true);
+    connect(&m_expiryTimer, &QTimer::timeout, this, &Service::expireRequests);
+
+    m_reconnectTimer.setSingleShot(true);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, &Service::connectToSocket);
+
+    m_outbox.load();
 
     connect(&m_webSocket, &QWebSocket::connected, this, &Service::onConnected);
     connect(&m_webSocket, &QWebSocket::disconnected, this, &Service::onDisconnected);
     connect(&m_webSocket, QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::errorOccurred), this, &Service::onError);
     connect(&m_webSocket, &QWebSocket::textMessageReceived, this, &Service::onTextMessageReceived);
+    connect(&m_webSocket, &QWebSocket::binaryMessageReceived, this, &Service::onBinaryMessageReceived);
 
     connect(&m_network, &Drivers::Network::Driver::loopbackInterfaceConnectedChanged, this, [this]() {
          if (m_network.loopbackInterfaceConnected()) {
@@ -39,7 +83,7 @@ Service::Service(Drivers::Network::Driver& network, QObject* parent)
         connectToSocket();
     }
     else {
-        qInfo() << "Waiting for network before connecting WebSocket to" << m_serverUrl;
+        qCInfo(lcWebSocket) << "Waiting for network before connecting WebSocket to" << m_serverUrl;
     }
 }
 
@@ -53,6 +97,58 @@ bool Service::connected() const
     return m_connected;
 }
 
+Encoding Service::encoding() const
+{
+    return m_encoding;
+}
+
+QString Service::encodingName() const
+{
+    return encodingToString(m_encoding);
+}
+
+int Service::requestsInFlight() const
+{
+    return m_pendingRequests.size();
+}
+
+int Service::requestsQueued() const
+{
+    return m_queuedRequests.size();
+}
+
+QVariantMap Service::requestLatencies() const
+{
+    QVariantMap latencies;
+    for (auto it = m_latencies.cbegin(); it != m_latencies.cend(); ++it) {
+        latencies[methodToString(it.key())] = it->toVariantMap();
+    }
+    return latencies;
+}
+
+int Service::outboxSize() const
+{
+    return m_outbox.size();
+}
+
+QVariantMap Service::topicCounters() const
+{
+    const qreal minutes = m_countersTimer.elapsed() / 60000.0;
+
+    QVariantMap counters;
+    for (auto it = m_topicCounters.cbegin(); it != m_topicCounters.cend(); ++it) {
+        QVariantMap counter;
+        counter["received"] = it->received;
+        counter["sent"] = it->sent;
+        counter["bytesReceived"] = it->bytesReceived;
+        counter["bytesSent"] = it->bytesSent;
+        counter["receivedPerMinute"] = minutes > 0 ? it->received / minutes : 0.0;
+        counter["sentPerMinute"] = minutes > 0 ? it->sent / minutes : 0.0;
+        counters[topicToString(it.key())] = counter;
+    }
+    return counters;
+}
+
 void Service::setServerUrl(const QString& url)
 {
     if (m_serverUrl == url) return;
@@ -67,51 +163,213 @@ void Service::setServerUrl(const QString& url)
     }
 }
 
-void Service::request(const Method& method, const QJsonObject& params, ResponseCallback callback)
+void Service::request(const Method& method, const QJsonObject& params, ResponseCallback callback, int timeoutMs)
 {
     if (!m_connected) {
-        qWarning() << "WebSocket not connected. Cannot send request:" << methodToString(method);
+        qCWarning(lcWebSocket) << "WebSocket not connected. Cannot send request:" << methodToString(method);
         if (callback) {
             callback(false, QJsonObject(), QStringLiteral("WebSocket not connected"));
         }
         return;
     }
 
+    QueuedRequest queued{method, params, callback, QDeadlineTimer(timeoutMs < 0 ? m_requestTimeoutMs : timeoutMs)};
+    if (m_pendingRequests.size() >= m_maxRequestsInFlight) {
+        if (m_queuedRequests.size() >= MAX_QUEUED_REQUESTS) {
+            qCWarning(lcWebSocket) << "WS request queue full, dropping request:" << methodToString(method);
+            if (callback) {
+                callback(false, QJsonObject(), QStringLiteral("Request queue full"));
+            }
+            return;
+        }
+
+        qCDebug(lcWebSocket) << "WS request queued:" << methodToString(method) << "," << m_pendingRequests.size() << "in flight";
+        m_queuedRequests.append(queued);
+        scheduleExpiry();
+        emit requestQueueChanged();
+        return;
+    }
+
+    sendRequest(queued);
+}
+
+void Service::sendRequest(const QueuedRequest& queued)
+{
     QString id = QString::number(m_nextRequestId++);
 
-    // Store callback for correlation
-    m_pendingRequests.insert(id, callback);
+    // Store callback for correlation; the latency runs from the moment the request is sent,
+    // the deadline from the moment it was made
+    PendingRequest pending{queued.method, queued.callback, QElapsedTimer(), queued.deadline};
+    pending.sent.start();
+    m_pendingRequests.insert(id, pending);
 
     QJsonObject req;
     req["jsonrpc"] = QStringLiteral("2.0");
     req["type"] = messageTypeToString(MessageType::Request);
-    req["method"] = methodToString(method);
-    req["params"] = params;
+    req["method"] = methodToString(queued.method);
+    req["params"] = queued.params;
     req["id"] = id;
 
-    QJsonDocument doc(req);
-    QString message = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
-    qInfo() << "WS request:" << message;
-    m_webSocket.sendTextMessage(message);
+    qCDebug(lcWebSocket) << "WS request:" << methodToString(queued.method) << "id" << id;
+    qCDebug(lcWebSocketPayload).noquote() << "WS request payload:" << formatPayload(req);
+    send(req);
+
+    scheduleExpiry();
+    emit requestQueueChanged();
+}
+
+void Service::sendQueuedRequests()
+{
+    while (m_connected && !m_queuedRequests.isEmpty() && m_pendingRequests.size() < m_maxRequestsInFlight) {
+        sendRequest(m_queuedRequests.takeFirst());
+    }
+}
+
+void Service::expireRequests()
+{
+    QList<ResponseCallback> expired;
+    for (auto it = m_pendingRequests.begin(); it != m_pendingRequests.end();) {
+        if (it->deadline.hasExpired()) {
+            qCWarning(lcWebSocket) << "WS request" << it.key() << methodToString(it->method) << "timed out after" << it->sent.elapsed() << "ms";
+            m_latencies[it->method].addTimeout();
+            expired.append(it->callback);
+            it = m_pendingRequests.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // Requests that waited in the queue for their whole deadline are never sent
+    for (auto it = m_queuedRequests.begin(); it != m_queuedRequests.end();) {
+        if (it->deadline.hasExpired()) {
+            qCWarning(lcWebSocket) << "WS request" << methodToString(it->method) << "timed out in the queue";
+            m_latencies[it->method].addTimeout();
+            expired.append(it->callback);
+            it = m_queuedRequests.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    if (!expired.isEmpty()) {
+        emit requestLatenciesChanged();
+        emit requestQueueChanged();
+    }
+
+    // Callbacks last, they may issue new requests
+    for (const ResponseCallback& callback : std::as_const(expired)) {
+        if (callback) {
+            callback(false, QJsonObject(), QStringLiteral("Request timed out"));
+        }
+    }
+
+    sendQueuedRequests();
+    scheduleExpiry();
+}
+
+void Service::scheduleExpiry()
+{
+    if (m_pendingRequests.isEmpty() && m_queuedRequests.isEmpty()) {
+        m_expiryTimer.stop();
+        return;
+    }
+
+    // A negative configured timeout makes a deadline that never expires, it reports -1 remaining
+    qint64 next = std::numeric_limits<qint64>::max();
+    for (const PendingRequest& pending : std::as_const(m_pendingRequests)) {
+        if (!pending.deadline.isForever()) {
+            next = qMin(next, pending.deadline.remainingTime());
+        }
+    }
+    for (const QueuedRequest& queued : std::as_const(m_queuedRequests)) {
+        if (!queued.deadline.isForever()) {
+            next = qMin(next, queued.deadline.remainingTime());
+        }
+    }
+    if (next == std::numeric_limits<qint64>::max()) {
+        m_expiryTimer.stop();
+        return;
+    }
+    m_expiryTimer.start(static_cast<int>(qBound<qint64>(0, next, std::numeric_limits<int>::max())));
+}
+
+void Service::failAllRequests(const QString& error)
+{
+    QList<ResponseCallback> callbacks;
+    for (const PendingRequest& pending : std::as_const(m_pendingRequests)) {
+        callbacks.append(pending.callback);
+    }
+    for (const QueuedRequest& queued : std::as_const(m_queuedRequests)) {
+        callbacks.append(queued.callback);
+    }
+    m_pendingRequests.clear();
+    m_queuedRequests.clear();
+    m_expiryTimer.stop();
+    emit requestQueueChanged();
+
+    for (const ResponseCallback& callback : std::as_const(callbacks)) {
+        if (callback) {
+            callback(false, QJsonObject(), error);
+        }
+    }
 }
 
 void Service::publish(const Topic& topic, const QJsonObject& params)
 {
     if (!m_connected) {
-        qWarning() << "WebSocket not connected. Cannot publish to topic:" << topic;
+        qCInfo(lcWebSocket) << "WebSocket not connected, keeping publish to" << topicToString(topic) << "in outbox";
+        m_outbox.put(topic, params);
+        emit outboxSizeChanged();
         return;
     }
 
+    sendPublish(topic, params);
+}
+
+void Service::sendPublish(const Topic& topic, const QJsonObject& params)
+{
     QJsonObject msg;
     msg["jsonrpc"] = QStringLiteral("2.0");
     msg["type"] = messageTypeToString(MessageType::Publish);
     msg["topic"] = topicToString(topic);
     msg["params"] = params;
 
-    QJsonDocument doc(msg);
-    QString message = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
-    qInfo() << "WS publish:" << message;
-    m_webSocket.sendTextMessage(message);
+    qint64 bytes = send(msg);
+    TopicCounter& counter = m_topicCounters[topic];
+    ++counter.sent;
+    counter.bytesSent += bytes;
+
+    qCDebug(lcWebSocket) << "WS publish:" << topicToString(topic) << bytes << "bytes";
+    qCDebug(lcWebSocketPayload).noquote() << "WS publish payload:" << formatPayload(msg);
+}
+
+void Service::flushOutbox()
+{
+    if (m_outbox.isEmpty()) {
+        return;
+    }
+
+    const QList<Outbox::Entry> entries = m_outbox.takeAll();
+    qCInfo(lcWebSocket) << "Sending" << entries.size() << "publishes queued while disconnected";
+    for (const Outbox::Entry& entry : entries) {
+        sendPublish(entry.topic, entry.params);
+    }
+    emit outboxSizeChanged();
+}
+
+void Service::scheduleReconnect()
+{
+    // Full jitter between half and all of the exponential delay, so a fleet of clocks
+    // does not reconnect in lockstep after a backend restart
+    const int exponent = qMin(m_reconnectAttempts, 16);
+    const int delay = qMin(RECONNECT_MAX_DELAY_MS, RECONNECT_BASE_DELAY_MS << exponent);
+    const int jitteredDelay = delay / 2 + QRandomGenerator::global()->bounded(delay / 2 + 1);
+    ++m_reconnectAttempts;
+
+    qCInfo(lcWebSocket) << "Reconnecting WebSocket in" << jitteredDelay << "ms (attempt" << m_reconnectAttempts << ")";
+    m_reconnectTimer.start(jitteredDelay);
 }
 
 void Service::subscribe(const Topic& topic)
@@ -121,7 +379,7 @@ void Service::subscribe(const Topic& topic)
     }
 
     if (!m_connected) {
-        qDebug() << "Will subscribe to" << topic << "when connected";
+        qCDebug(lcWebSocket) << "Will subscribe to" << topic << "when connected";
         return;
     }
 
@@ -129,9 +387,9 @@ void Service::subscribe(const Topic& topic)
     params["topic"] = topicToString(topic);
     request(Method::Subscribe, params, [topic](bool success, const QJsonObject&, const QString& error) {
         if (success) {
-            qInfo() << "Subscribed to topic:" << topic;
+            qCInfo(lcWebSocket) << "Subscribed to topic:" << topic;
         } else {
-            qWarning() << "Failed to subscribe to" << topic << ":" << error;
+            qCWarning(lcWebSocket) << "Failed to subscribe to" << topic << ":" << error;
         }
     });
 }
@@ -148,9 +406,9 @@ void Service::unsubscribe(const Topic& topic)
     params["topic"] = topicToString(topic);
     request(Method::Unsubscribe, params, [topic](bool success, const QJsonObject&, const QString& error) {
         if (success) {
-            qInfo() << "Unsubscribed from topic:" << topic;
+            qCInfo(lcWebSocket) << "Unsubscribed from topic:" << topic;
         } else {
-            qWarning() << "Failed to unsubscribe from" << topic << ":" << error;
+            qCWarning(lcWebSocket) << "Failed to unsubscribe from" << topic << ":" << error;
         }
     });
 }
@@ -161,91 +419,141 @@ void Service::connectToSocket()
     if (m_webSocket.state() == QAbstractSocket::ConnectedState ||
         m_webSocket.state() == QAbstractSocket::ConnectingState) return;
 
-    qDebug() << "Connecting WebSocket to" << m_serverUrl;
-    m_webSocket.open(QUrl(m_serverUrl));
+    QWebSocketHandshakeOptions options;
+    if (m_binaryEnabled) {
+        options.setSubprotocols({SUBPROTOCOL_CBOR, SUBPROTOCOL_JSON});
+    }
+
+    m_reconnectTimer.stop();
+    qCDebug(lcWebSocket) << "Connecting WebSocket to" << m_serverUrl;
+    m_webSocket.open(QNetworkRequest(QUrl(m_serverUrl)), options);
 }
 
 void Service::disconnectFromSocket()
 {
+    m_reconnectTimer.stop();
     m_webSocket.close();
 }
 
 void Service::onConnected()
 {
-    qInfo() << "WebSocket Connected";
+    const QString subprotocol = m_webSocket.subprotocol();
+    if (subprotocol == SUBPROTOCOL_CBOR) {
+        m_encoding = Encoding::Cbor;
+    }
+    else if (subprotocol == SUBPROTOCOL_JSON) {
+        m_encoding = Encoding::BinaryJson;
+    }
+    else {
+        m_encoding = Encoding::Text;
+    }
+    qCInfo(lcWebSocket) << "WebSocket Connected, using" << encodingToString(m_encoding) << "encoding";
     m_connected = true;
     emit connectedChanged();
 
+    m_reconnectAttempts = 0;
+
     // Subscribe to all topics on the server
     resubscribeAll();
+    flushOutbox();
 }
 
 void Service::onDisconnected()
 {
-    qInfo() << "WebSocket Disconnected, TODO: raise notification that internal communication failed.";
-
-    // Clear pending requests — they will never get a response
-    for (auto it = m_pendingRequests.begin(); it != m_pendingRequests.end(); ++it) {
-        if (it.value()) {
-            it.value()(false, QJsonObject(), QStringLiteral("WebSocket disconnected"));
-        }
-    }
-    m_pendingRequests.clear();
+    qCInfo(lcWebSocket) << "WebSocket Disconnected, TODO: raise notification that internal communication failed.";
 
     if (m_connected) {
         m_connected = false;
         emit connectedChanged();
     }
 
+    // Pending and queued requests will never get a response
+    failAllRequests(QStringLiteral("WebSocket disconnected"));
+
     if (m_network.loopbackInterfaceConnected()) {
-        QTimer::singleShot(RECONNECT_INTERVAL_MS, this, &Service::connectToSocket);
+        scheduleReconnect();
     }
 }
 
 void Service::onError(QAbstractSocket::SocketError error)
 {
-     qWarning() << "WebSocket Error:" << error << m_webSocket.errorString();
+     qCWarning(lcWebSocket) << "WebSocket Error:" << error << m_webSocket.errorString();
 }
 
 void Service::onTextMessageReceived(const QString& message)
 {
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
-    if (doc.isObject()) {
-        dispatchMessage(doc.object());
+    QJsonObject decoded;
+    QString error;
+    if (Codec::decode(message.toUtf8(), Encoding::Text, decoded, error)) {
+        dispatchMessage(decoded, message.size());
+    } else {
+        qCWarning(lcWebSocket) << "Received invalid JSON via WebSocket of" << message.size() << "characters:" << error;
+    }
+}
+
+void Service::onBinaryMessageReceived(const QByteArray& message)
+{
+    // Binary frames carry whatever was negotiated; no UTF-16 round trip in either case
+    QJsonObject decoded;
+    QString error;
+    if (Codec::decode(message, m_encoding, decoded, error)) {
+        dispatchMessage(decoded, message.size());
     } else {
-        qWarning() << "Received invalid JSON via WebSocket:" << message;
+        qCWarning(lcWebSocket) << "Received invalid" << encodingToString(m_encoding) << "message via WebSocket of" << message.size() << "bytes:" << error;
+    }
+}
+
+qint64 Service::send(const QJsonObject& message)
+{
+    const QByteArray frame = Codec::encode(message, m_encoding);
+    if (m_encoding == Encoding::Text) {
+        return m_webSocket.sendTextMessage(QString::fromUtf8(frame));
     }
+    return m_webSocket.sendBinaryMessage(frame);
 }
 
-void Service::dispatchMessage(const QJsonObject& message)
+void Service::dispatchMessage(const QJsonObject& message, qint64 bytes)
 {
-    qInfo() << "WS dispatchMessage:" << QString::fromUtf8(QJsonDocument(message).toJson(QJsonDocument::Compact));
     MessageType type = messageTypeFromString(message["type"].toString());
+    qCDebug(lcWebSocket) << "WS received" << type << bytes << "bytes";
+    qCDebug(lcWebSocketPayload).noquote() << "WS received payload:" << formatPayload(message);
 
     if (type == MessageType::Response) {
         // Correlated response — look up callback by id
         QString id = message["id"].toString();
         if (m_pendingRequests.contains(id)) {
-            ResponseCallback callback = m_pendingRequests.take(id);
-            if (message.contains("error")) {
+            PendingRequest pending = m_pendingRequests.take(id);
+            m_latencies[pending.method].add(pending.sent.elapsed());
+            emit requestLatenciesChanged();
+            emit requestQueueChanged();
+
+            ResponseCallback callback = pending.callback;
+            if (callback && message.contains("error")) {
                 QString error = message["error"].toObject()["message"].toString();
                 callback(false, QJsonObject(), error);
-            } else {
+            } else if (callback) {
                 QJsonObject result = message["result"].toObject();
                 callback(true, result, QString());
             }
+
+            sendQueuedRequests();
+            scheduleExpiry();
         } else {
-            qDebug() << "Received response for unknown request id:" << id;
+            qCDebug(lcWebSocket) << "Received response for unknown (or timed out) request id:" << id;
         }
     }
     else if (type == MessageType::Publish) {
         // Topic-based publish from server
         Topic topic = topicFromString(message["topic"].toString());
+        TopicCounter& counter = m_topicCounters[topic];
+        ++counter.received;
+        counter.bytesReceived += bytes;
+
         QJsonObject data = message["params"].toObject();
         emit publishReceived(topic, data);
     }
     else {
-        qWarning() << "Unknown message type received:" << type;
+        qCWarning(lcWebSocket) << "Unknown message type received:" << type;
     }
 }
 
@@ -256,19 +564,31 @@ void Service::resubscribeAll()
         params["topic"] = topicToString(topic);
         request(Method::Subscribe, params, [topic](bool success, const QJsonObject&, const QString& error) {
             if (success) {
-                qInfo() << "Subscribed to topic:" << topicToString(topic);
+                qCInfo(lcWebSocket) << "Subscribed to topic:" << topicToString(topic);
             } else {
-                qWarning() << "Failed to subscribe to" << topicToString(topic) << ":" << error;
+                qCWarning(lcWebSocket) << "Failed to subscribe to" << topicToString(topic) << ":" << error;
             }
         });
     }
 }
 
+QString Service::formatPayload(const QJsonObject& payload)
+{
+    QByteArray json = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+    if (json.size() <= PAYLOAD_LOG_LIMIT) {
+        return QString::fromUtf8(json);
+    }
+    return QString::fromUtf8(json.left(PAYLOAD_LOG_LIMIT)) + QStringLiteral("... (%1 bytes)").arg(json.size());
+}
+
 void Service::loadProperties()
 {
     QSettings settings;
     settings.beginGroup(PROPERTIES_GROUP_NAME);
     m_serverUrl = settings.value(PROPERTY_SERVER_URL_KEY, PROPERTY_SERVER_URL_DEFAULT).toString();
+    m_binaryEnabled = settings.value(PROPERTY_BINARY_KEY, PROPERTY_BINARY_DEFAULT).toBool();
+    m_maxRequestsInFlight = qMax(1, settings.value(PROPERTY_MAX_REQUESTS_IN_FLIGHT_KEY, PROPERTY_MAX_REQUESTS_IN_FLIGHT_DEFAULT).toInt());
+    m_requestTimeoutMs = settings.value(PROPERTY_REQUEST_TIMEOUT_KEY, PROPERTY_REQUEST_TIMEOUT_DEFAULT).toInt();
     settings.endGroup();
 }
 
@@ -1,14 +1,20 @@
 #ifndef SERVICES_WEBSOCKET_SERVICE_H
 #define SERVICES_WEBSOCKET_SERVICE_H
 
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
 #include <QHash>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QObject>
+#include <QTimer>
+#include <QVariantMap>
 #include <QWebSocket>
 
 #include <functional>
 
+#include "LatencyHistogram.h"
+#include "Outbox.h"
 #include "Types.h"
 
 namespace Drivers::Network
@@ -24,6 +30,11 @@ class Service : public QObject
     Q_OBJECT
     Q_PROPERTY(QString serverUrl READ serverUrl WRITE setServerUrl NOTIFY serverUrlChanged)
     Q_PROPERTY(bool connected READ connected NOTIFY connectedChanged)
+    Q_PROPERTY(QString encoding READ encodingName NOTIFY connectedChanged)
+    Q_PROPERTY(int requestsInFlight READ requestsInFlight NOTIFY requestQueueChanged)
+    Q_PROPERTY(int requestsQueued READ requestsQueued NOTIFY requestQueueChanged)
+    Q_PROPERTY(QVariantMap requestLatencies READ requestLatencies NOTIFY requestLatenciesChanged)
+    Q_PROPERTY(int outboxSize READ outboxSize NOTIFY outboxSizeChanged)
 
   public:
     using ResponseCallback = std::function<void(bool success, const QJsonObject& result, const QString& error)>;
@@ -32,19 +43,38 @@ class Service : public QObject
 
     QString serverUrl() const;
     bool connected() const;
+    Encoding encoding() const;
+    QString encodingName() const;
+    int requestsInFlight() const;
+    int requestsQueued() const;
+
+    /**
+     * Round-trip latency histogram and timeout count per method, keyed by method name.
+     */
+    QVariantMap requestLatencies() const;
+    int outboxSize() const;
 
     void setServerUrl(const QString& url);
 
+    /**
+     * Message and byte counts per topic since startup, with their average rate per minute.
+     */
+    Q_INVOKABLE QVariantMap topicCounters() const;
+
     /**
      * Send a request to the server and receive a correlated response via callback.
-     * The request is assigned an auto-incrementing id for correlation.
+     * The request is assigned an auto-incrementing id for correlation. When too many
+     * requests are in flight it is queued; the callback fails once timeoutMs (or the
+     * configured default when negative) passed since this call without a response, queued
+     * or not. It fails right away when the queue is full.
      */
-    void request(const Method& method, const QJsonObject& params, ResponseCallback callback);
+    void request(const Method& method, const QJsonObject& params, ResponseCallback callback, int timeoutMs = -1);
 
     /**
      * Publish a message to a topic (fire-and-forget, no response expected).
      * Used for both app→backend notifications (e.g. status.update) and
      * backend→app broadcasts (e.g. configuration).
+     * While disconnected the latest publish per topic is kept in the outbox and sent on reconnect.
      */
     void publish(const Topic& topic, const QJsonObject& params = QJsonObject());
 
@@ -59,9 +89,18 @@ class Service : public QObject
      */
     void unsubscribe(const Topic& topic);
 
+    /**
+     * Compact JSON of a payload for the log, truncated to a readable length. Only call it from
+     * inside a qCDebug() of a payload category, so nothing is serialized unless it is enabled.
+     */
+    static QString formatPayload(const QJsonObject& payload);
+
   signals:
     void serverUrlChanged();
     void connectedChanged();
+    void requestQueueChanged();
+    void requestLatenciesChanged();
+    void outboxSizeChanged();
 
     /**
      * Emitted when a publish message is received from the server for a subscribed topic.
@@ -69,6 +108,30 @@ class Service : public QObject
     void publishReceived(const Topic& topic, const QJsonObject& data);
 
   private:
+    struct TopicCounter
+    {
+        quint64 received = 0;
+        quint64 sent = 0;
+        qint64 bytesReceived = 0;
+        qint64 bytesSent = 0;
+    };
+
+    struct PendingRequest
+    {
+        Method method;
+        ResponseCallback callback;
+        QElapsedTimer sent;
+        QDeadlineTimer deadline;
+    };
+
+    struct QueuedRequest
+    {
+        Method method;
+        QJsonObject params;
+        ResponseCallback callback;
+        QDeadlineTimer deadline; // Runs from the request() call
+    };
+
     void loadProperties();
     void saveProperty(const QString& key, const QVariant& value);
     void connectToSocket();
@@ -77,16 +140,38 @@ class Service : public QObject
     void onDisconnected();
     void onError(QAbstractSocket::SocketError error);
     void onTextMessageReceived(const QString& message);
-    void dispatchMessage(const QJsonObject& message);
+    void onBinaryMessageReceived(const QByteArray& message);
+    qint64 send(const QJsonObject& message);
+    void dispatchMessage(const QJsonObject& message, qint64 bytes);
     void resubscribeAll();
+    void sendRequest(const QueuedRequest& queued);
+    void sendQueuedRequests();
+    void expireRequests();
+    void scheduleExpiry();
+    void failAllRequests(const QString& error);
+    void sendPublish(const Topic& topic, const QJsonObject& params);
+    void flushOutbox();
+    void scheduleReconnect();
 
     Drivers::Network::Driver& m_network;
     QWebSocket m_webSocket;
     QString m_serverUrl;
     bool m_connected;
+    bool m_binaryEnabled;
+    Encoding m_encoding;
     int m_nextRequestId;
-    QHash<QString, ResponseCallback> m_pendingRequests;
+    int m_maxRequestsInFlight;
+    int m_requestTimeoutMs;
+    QHash<QString, PendingRequest> m_pendingRequests;
+    QList<QueuedRequest> m_queuedRequests;
+    QTimer m_expiryTimer;
+    QHash<Method, LatencyHistogram> m_latencies;
     QList<Topic> m_subscribedTopics;
+    QHash<Topic, TopicCounter> m_topicCounters;
+    Outbox m_outbox;
+    QTimer m_reconnectTimer;
+    int m_reconnectAttempts;
+    QElapsedTimer m_countersTimer;
 };
 
 } // namespace Services::WebSocket
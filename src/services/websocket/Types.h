@@ -16,6 +16,14 @@ enum class MessageType
 };
 Q_ENUM_NS(MessageType)
 
+enum class Encoding
+{
+    Text,       // JSON in text frames
+    BinaryJson, // Compact JSON in binary frames
+    Cbor        // CBOR in binary frames
+};
+Q_ENUM_NS(Encoding)
+
 enum class Method
 {
     Subscribe,
@@ -35,6 +43,18 @@ enum class Topic
 };
 Q_ENUM_NS(Topic)
 
+inline QString encodingToString(Encoding encoding)
+{
+    switch (encoding) {
+    case Encoding::BinaryJson:
+        return "json";
+    case Encoding::Cbor:
+        return "cbor";
+    default:
+        return "text";
+    }
+}
+
 inline MessageType messageTypeFromString(const QString& typeStr)
 {
     if (typeStr == "request") {
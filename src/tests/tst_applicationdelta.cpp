@@ -0,0 +1,229 @@
+#include "applications/ApplicationDelta.h"
+#include "applications/common/Application.h"
+#include "applications/common/Configuration.h"
+#include "services/configuration/ConfigurationDelta.h"
+#include "services/configuration/DeviceConfiguration.h"
+#include <QMetaProperty>
+#include <QPointer>
+#include <QSignalSpy>
+#include <QTest>
+#include <memory>
+#include <vector>
+
+using Applications::ApplicationDelta;
+using Services::Configuration::ConfigurationDelta;
+using Services::Configuration::DeviceConfiguration;
+
+/**
+ * Application with only the common configuration, the way the container creates them.
+ */
+class StubApplication : public Common::Application
+{
+  public:
+    explicit StubApplication(const QJsonObject& appConfig)
+        : Common::Application(appConfig["id"].toString(), Common::Type::Clock, appConfig["name"].toString(), appConfig["order"].toInt(), Common::Watchface::AnalogClock),
+          m_configuration(new Common::Configuration(appConfig["id"].toString(), this))
+    {
+    }
+
+    void applyConfiguration(const QJsonObject& config) override
+    {
+        m_configuration->fromJson(config);
+    }
+
+    Common::Configuration* configuration() const override
+    {
+        return m_configuration;
+    }
+
+  private:
+    Common::Configuration* m_configuration;
+};
+
+/**
+ * Records the NOTIFY signals of every property of a configuration.
+ */
+class NotifyRecorder
+{
+  public:
+    explicit NotifyRecorder(const QObject* object)
+    {
+        const QMetaObject* meta = object->metaObject();
+        for (int i = meta->propertyOffset(); i < meta->propertyCount(); ++i) {
+            const QMetaMethod signal = meta->property(i).notifySignal();
+            if (signal.isValid() && !m_names.contains(signal.name())) {
+                m_names.append(signal.name());
+                m_spies.push_back(std::make_unique<QSignalSpy>(object, signal));
+            }
+        }
+    }
+
+    /**
+     * Names of the signals that fired since the recorder was created.
+     */
+    QStringList emitted() const
+    {
+        QStringList names;
+        for (size_t i = 0; i < m_spies.size(); ++i) {
+            if (!m_spies[i]->isEmpty()) {
+                names.append(QString::fromLatin1(m_names.at(i)));
+            }
+        }
+        return names;
+    }
+
+  private:
+    QByteArrayList m_names;
+    std::vector<std::unique_ptr<QSignalSpy>> m_spies;
+};
+
+namespace
+{
+QJsonObject application(const QString& id, int order)
+{
+    return QJsonObject{
+        {"id", id},
+        {"type", "clock"},
+        {"name", id},
+        {"order", order},
+        {"watchface", "clock"},
+        {"enabled", true},
+        {"background", id + ".gif"},
+        {"base-color", "#995000"},
+        {"weight", 1},
+    };
+}
+
+DeviceConfiguration configuration(const QList<QJsonObject>& applications)
+{
+    DeviceConfiguration configuration;
+    configuration.applications = applications;
+    return configuration;
+}
+
+/**
+ * Applications as the container holds them after a reload of the given configuration.
+ */
+Common::DynamicApplicationMap create(const DeviceConfiguration& configuration)
+{
+    Common::DynamicApplicationMap applications;
+    for (const QJsonObject& appConfig : configuration.applications) {
+        StubApplication* app = new StubApplication(appConfig);
+        app->applyConfiguration(appConfig);
+        applications[app->id()] = app;
+    }
+    return applications;
+}
+
+ApplicationDelta::Factory factory()
+{
+    return [](const QJsonObject& appConfig) -> Common::Application* {
+        StubApplication* app = new StubApplication(appConfig);
+        app->applyConfiguration(appConfig);
+        return app;
+    };
+}
+} // namespace
+
+class TestApplicationDelta : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void keepsUnchangedApplications();
+    void notifiesOnlyChangedFields_data();
+    void notifiesOnlyChangedFields();
+    void replacesRemovedAndAddedApplications();
+};
+
+void TestApplicationDelta::keepsUnchangedApplications()
+{
+    const DeviceConfiguration previous = configuration({application("a", 0), application("b", 1)});
+    QJsonObject changed = application("b", 1);
+    changed["base-color"] = "#002244";
+    const DeviceConfiguration current = configuration({application("a", 0), changed});
+
+    Common::DynamicApplicationMap applications = create(previous);
+    const Common::DynamicApplicationMap before = applications;
+    NotifyRecorder unchanged(applications["a"]->configuration());
+
+    const ApplicationDelta applied = ApplicationDelta::apply(ConfigurationDelta::compute(previous, current), applications, factory());
+    QCOMPARE(applied.created, 0);
+    QCOMPARE(applied.destroyed, 0);
+    QCOMPARE(applied.updated, 1);
+    QCOMPARE(applications, before);
+    QCOMPARE(unchanged.emitted(), QStringList());
+
+    qDeleteAll(applications);
+}
+
+void TestApplicationDelta::notifiesOnlyChangedFields_data()
+{
+    QTest::addColumn<QJsonObject>("changes");
+    QTest::addColumn<QStringList>("emitted");
+    QTest::addColumn<bool>("rotationChanged");
+    QTest::addColumn<bool>("backgroundsChanged");
+
+    QTest::newRow("color") << QJsonObject{{"base-color", "#002244"}} << QStringList{"baseColorChanged"} << false << false;
+    QTest::newRow("background") << QJsonObject{{"background", "other.gif"}} << QStringList{"backgroundChanged"} << false << true;
+    QTest::newRow("disabled") << QJsonObject{{"enabled", false}} << QStringList{"enabledChanged"} << true << true;
+    QTest::newRow("weight") << QJsonObject{{"weight", 3}} << QStringList{"scheduleChanged"} << true << false;
+    QTest::newRow("color and opacity") << QJsonObject{{"accent-color", "#ffffff"}, {"background-opacity", 0.5}}
+                                       << QStringList{"backgroundOpacityChanged", "accentColorChanged"} << false << false;
+}
+
+void TestApplicationDelta::notifiesOnlyChangedFields()
+{
+    QFETCH(QJsonObject, changes);
+    QFETCH(QStringList, emitted);
+    QFETCH(bool, rotationChanged);
+    QFETCH(bool, backgroundsChanged);
+
+    const DeviceConfiguration previous = configuration({application("a", 0)});
+    QJsonObject changed = application("a", 0);
+    for (auto it = changes.constBegin(); it != changes.constEnd(); ++it) {
+        changed[it.key()] = it.value();
+    }
+    const DeviceConfiguration current = configuration({changed});
+
+    Common::DynamicApplicationMap applications = create(previous);
+    Common::Application* app = applications["a"];
+    NotifyRecorder recorder(app->configuration());
+
+    const ApplicationDelta applied = ApplicationDelta::apply(ConfigurationDelta::compute(previous, current), applications, factory());
+    QCOMPARE(applications["a"], app);
+    QCOMPARE(applied.updated, 1);
+    QCOMPARE(recorder.emitted(), emitted);
+    QCOMPARE(applied.rotationChanged, rotationChanged);
+    QCOMPARE(applied.backgroundsChanged, backgroundsChanged);
+
+    qDeleteAll(applications);
+}
+
+void TestApplicationDelta::replacesRemovedAndAddedApplications()
+{
+    const DeviceConfiguration previous = configuration({application("a", 0), application("b", 1)});
+    const DeviceConfiguration current = configuration({application("a", 0), application("c", 1)});
+
+    Common::DynamicApplicationMap applications = create(previous);
+    Common::Application* kept = applications["a"];
+    QPointer<Common::Application> removed = applications["b"];
+    NotifyRecorder recorder(kept->configuration());
+
+    const ApplicationDelta applied = ApplicationDelta::apply(ConfigurationDelta::compute(previous, current), applications, factory());
+    QCOMPARE(applied.destroyed, 1);
+    QCOMPARE(applied.created, 1);
+    QCOMPARE(applied.updated, 0);
+    QVERIFY(applied.rotationChanged);
+    QVERIFY(applied.backgroundsChanged);
+
+    QVERIFY(removed.isNull());
+    QCOMPARE(applications.keys(), QStringList({"a", "c"}));
+    QCOMPARE(applications["a"], kept);
+    QCOMPARE(recorder.emitted(), QStringList());
+
+    qDeleteAll(applications);
+}
+
+QTEST_GUILESS_MAIN(TestApplicationDelta)
+#include "tst_applicationdelta.moc"
@@ -0,0 +1,140 @@
+#include "services/configuration/ConfigurationDelta.h"
+#include "services/configuration/DeviceConfiguration.h"
+#include <QTest>
+
+using namespace Services::Configuration;
+
+namespace
+{
+QJsonObject clockApplication()
+{
+    return QJsonObject{
+        {"id", "clock"},
+        {"type", "clock"},
+        {"name", "Klok"},
+        {"order", 0},
+        {"watchface", "clock"},
+        {"background", "giphy_3.gif"},
+        {"hour-color", "#995000"},
+    };
+}
+
+QJsonObject timerApplication()
+{
+    return QJsonObject{
+        {"id", "married-timer"},
+        {"type", "time-elapsed"},
+        {"name", "Trouw Timer"},
+        {"order", 1},
+        {"watchface", "seven-segment"},
+        {"timestamp", 1730332800},
+    };
+}
+
+DeviceConfiguration baseConfiguration()
+{
+    DeviceConfiguration configuration;
+    configuration.systemConfiguration = QJsonObject{
+        {"brightness", 0.8},
+        {"volume", 0.5},
+    };
+    configuration.applications = {clockApplication(), timerApplication()};
+    return configuration;
+}
+} // namespace
+
+class TestConfigurationDelta : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void isEmptyWithoutChanges();
+    void reportsSystemKeys();
+    void reportsAddedAndRemovedApplications();
+    void reportsOnlyChangedFields();
+    void replacesApplicationWithChangedMetadata();
+    void replacesApplicationThatLostAField();
+};
+
+void TestConfigurationDelta::isEmptyWithoutChanges()
+{
+    const ConfigurationDelta delta = ConfigurationDelta::compute(baseConfiguration(), baseConfiguration());
+    QVERIFY(delta.isEmpty());
+}
+
+void TestConfigurationDelta::reportsSystemKeys()
+{
+    DeviceConfiguration current = baseConfiguration();
+    current.systemConfiguration["brightness"] = 0.3;
+    current.systemConfiguration["base-color"] = "#000000";
+    current.systemConfiguration.remove("volume");
+
+    const ConfigurationDelta delta = ConfigurationDelta::compute(baseConfiguration(), current);
+    QCOMPARE(delta.changedSystemKeys, QJsonObject({{"brightness", 0.3}, {"base-color", "#000000"}}));
+    QCOMPARE(delta.removedSystemKeys, QStringList({"volume"}));
+    QVERIFY(delta.addedApplications.isEmpty());
+    QVERIFY(delta.changedApplications.isEmpty());
+    QVERIFY(delta.removedApplications.isEmpty());
+}
+
+void TestConfigurationDelta::reportsAddedAndRemovedApplications()
+{
+    QJsonObject countdown{
+        {"id", "countdown"},
+        {"type", "countdown"},
+        {"name", "Aftellen"},
+        {"order", 1},
+        {"watchface", "countdown"},
+    };
+
+    DeviceConfiguration current = baseConfiguration();
+    current.applications = {clockApplication(), countdown};
+
+    const ConfigurationDelta delta = ConfigurationDelta::compute(baseConfiguration(), current);
+    QCOMPARE(delta.addedApplications, QList<QJsonObject>({countdown}));
+    QCOMPARE(delta.removedApplications, QStringList({"married-timer"}));
+    QVERIFY(delta.changedApplications.isEmpty());
+    QVERIFY(delta.changedSystemKeys.isEmpty());
+}
+
+void TestConfigurationDelta::reportsOnlyChangedFields()
+{
+    DeviceConfiguration current = baseConfiguration();
+    current.applications[0]["background"] = "married_vhs.gif";
+    current.applications[0]["minute-color"] = "#005099";
+
+    const ConfigurationDelta delta = ConfigurationDelta::compute(baseConfiguration(), current);
+    const QJsonObject expected{
+        {"id", "clock"},
+        {"background", "married_vhs.gif"},
+        {"minute-color", "#005099"},
+    };
+    QCOMPARE(delta.changedApplications, QList<QJsonObject>({expected}));
+    QVERIFY(delta.addedApplications.isEmpty());
+    QVERIFY(delta.removedApplications.isEmpty());
+}
+
+void TestConfigurationDelta::replacesApplicationWithChangedMetadata()
+{
+    DeviceConfiguration current = baseConfiguration();
+    current.applications[1]["watchface"] = "round-progress-bar";
+
+    const ConfigurationDelta delta = ConfigurationDelta::compute(baseConfiguration(), current);
+    QCOMPARE(delta.removedApplications, QStringList({"married-timer"}));
+    QCOMPARE(delta.addedApplications, QList<QJsonObject>({current.applications[1]}));
+    QVERIFY(delta.changedApplications.isEmpty());
+}
+
+void TestConfigurationDelta::replacesApplicationThatLostAField()
+{
+    DeviceConfiguration current = baseConfiguration();
+    current.applications[0].remove("hour-color");
+
+    const ConfigurationDelta delta = ConfigurationDelta::compute(baseConfiguration(), current);
+    QCOMPARE(delta.removedApplications, QStringList({"clock"}));
+    QCOMPARE(delta.addedApplications, QList<QJsonObject>({current.applications[0]}));
+    QVERIFY(delta.changedApplications.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestConfigurationDelta)
+#include "tst_configurationdelta.moc"
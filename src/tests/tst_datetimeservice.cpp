@@ -0,0 +1,85 @@
+#include "services/datetime/Service.h"
+#include <QDateTime>
+#include <QTest>
+
+using Services::DateTime::Service;
+
+namespace
+{
+qint64 utcMs(const QString& isoDateTime)
+{
+    return QDateTime::fromString(isoDateTime, Qt::ISODate).toMSecsSinceEpoch();
+}
+} // namespace
+
+/**
+ * Local time fields against QTimeZone, and the CPU cost of one second tick with the cached
+ * UTC offset against converting to the time zone and parsing the formatted string, as
+ * Clock.qml used to do on every read.
+ */
+class TestDateTimeService : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void followsTimeZone_data();
+    void followsTimeZone();
+
+    void tickTimeZoneConversion();
+    void tickCachedOffset();
+};
+
+void TestDateTimeService::followsTimeZone_data()
+{
+    QTest::addColumn<QStringList>("instants");
+
+    QTest::newRow("summer time starts") << QStringList({"2026-03-29T00:59:59Z", "2026-03-29T01:00:00Z"});
+    QTest::newRow("summer time ends") << QStringList({"2026-10-25T00:59:59Z", "2026-10-25T01:00:00Z"});
+    QTest::newRow("clock set back") << QStringList({"2026-07-01T12:00:00Z", "2026-01-15T23:30:00Z"});
+    QTest::newRow("clock set forward") << QStringList({"2026-01-15T23:30:00Z", "2026-07-01T12:00:00Z"});
+}
+
+void TestDateTimeService::followsTimeZone()
+{
+    QFETCH(QStringList, instants);
+
+    Service service;
+    for (const QString& instant : std::as_const(instants)) {
+        const qint64 ms = utcMs(instant);
+        service.refresh(ms);
+
+        const QTime expected = QDateTime::fromMSecsSinceEpoch(ms, QTimeZone(QTimeZone::UTC)).toTimeZone(service.m_timeZone).time();
+        QCOMPARE(service.m_hours, expected.hour());
+        QCOMPARE(service.m_minutes, expected.minute());
+        QCOMPARE(service.m_seconds, expected.second());
+    }
+}
+
+void TestDateTimeService::tickTimeZoneConversion()
+{
+    Service service;
+    int sum = 0;
+    QBENCHMARK {
+        const QString time = QDateTime::currentDateTimeUtc().toTimeZone(service.m_timeZone).toString("HH:mm:ss");
+        const QStringList parts = time.split(':');
+        sum += parts.at(0).toInt() + parts.at(1).toInt() + parts.at(2).toInt();
+    }
+    QVERIFY(sum >= 0);
+}
+
+void TestDateTimeService::tickCachedOffset()
+{
+    Service service;
+    qint64 now = utcMs("2026-06-01T12:00:00Z");
+    int sum = 0;
+    QBENCHMARK {
+        // Every iteration is a new second, so nothing comes from the per second cache
+        now += 1000;
+        service.refresh(now);
+        sum += service.m_hours + service.m_minutes + service.m_seconds;
+    }
+    QVERIFY(sum >= 0);
+}
+
+QTEST_GUILESS_MAIN(TestDateTimeService)
+#include "tst_datetimeservice.moc"
@@ -0,0 +1,225 @@
+#include "drivers/network/Driver.h"
+#include "services/media/DownloadQueue.h"
+#include "services/rest/Service.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSet>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace Services::Media;
+
+/**
+ * Minimal HTTP server on the loopback interface that answers every request with a few bytes,
+ * or a 404 for missing files, and records the names of the requested files in the order the
+ * requests arrived.
+ */
+class MediaServer : public QObject
+{
+  public:
+    MediaServer()
+    {
+        connect(&m_server, &QTcpServer::newConnection, this, &MediaServer::onNewConnection);
+        m_server.listen(QHostAddress::LocalHost);
+    }
+
+    QString url() const
+    {
+        return QStringLiteral("http://127.0.0.1:%1").arg(m_server.serverPort());
+    }
+
+    QStringList requested;
+    QSet<QString> missing;
+
+  private:
+    void onNewConnection()
+    {
+        while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+            connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+                if (!socket->peek(socket->bytesAvailable()).contains("\r\n\r\n")) {
+                    return; // Headers not complete yet
+                }
+
+                const QByteArray requestLine = socket->readLine();
+                socket->readAll();
+                const QString filename = QString::fromLatin1(requestLine.split(' ').value(1)).section('/', -1);
+                requested.append(filename);
+
+                if (missing.contains(filename)) {
+                    socket->write("HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+                }
+                else {
+                    socket->write("HTTP/1.1 200 OK\r\nContent-Length: 4\r\nConnection: close\r\n\r\ndata");
+                }
+                socket->disconnectFromHost();
+            });
+        }
+    }
+
+    QTcpServer m_server;
+};
+
+class TestDownloadQueue : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void startsInQueueOrder();
+    void startsPrioritisedFilesFirst();
+    void dropsDuplicates();
+    void removesUnwantedPartialDownloads();
+    void cancelAllBecomesIdle();
+    void keepsAttemptsWhenTheListIsResent();
+
+  private:
+    Drivers::Network::Driver* m_network = nullptr;
+    Services::Rest::Service* m_rest = nullptr;
+    MediaServer* m_server = nullptr;
+    QTemporaryDir* m_directory = nullptr;
+};
+
+void TestDownloadQueue::initTestCase()
+{
+    // Keeps the server url out of the settings of the application
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void TestDownloadQueue::init()
+{
+    m_network = new Drivers::Network::Driver();
+    if (!m_network->loopbackInterfaceConnected()) {
+        QSKIP("The loopback interface is not up");
+    }
+
+    m_server = new MediaServer();
+    m_rest = new Services::Rest::Service(*m_network);
+    m_rest->setServerUrl(m_server->url());
+    m_directory = new QTemporaryDir();
+    QVERIFY(m_directory->isValid());
+}
+
+void TestDownloadQueue::cleanup()
+{
+    delete m_directory;
+    delete m_rest;
+    delete m_server;
+    delete m_network;
+    m_directory = nullptr;
+    m_rest = nullptr;
+    m_server = nullptr;
+    m_network = nullptr;
+}
+
+void TestDownloadQueue::startsInQueueOrder()
+{
+    DownloadQueue queue(*m_rest, m_directory->path());
+    queue.setMaxConcurrentDownloads(1);
+    QSignalSpy finished(&queue, &DownloadQueue::downloadFinished);
+
+    queue.replace({"a.gif", "b.gif", "c.gif"});
+
+    QTRY_COMPARE(finished.count(), 3);
+    QCOMPARE(m_server->requested, QStringList({"a.gif", "b.gif", "c.gif"}));
+    QVERIFY(queue.isIdle());
+}
+
+void TestDownloadQueue::startsPrioritisedFilesFirst()
+{
+    DownloadQueue queue(*m_rest, m_directory->path());
+    queue.setMaxConcurrentDownloads(1);
+    queue.setPriorities({"d.gif", "b.gif"});
+    QSignalSpy finished(&queue, &DownloadQueue::downloadFinished);
+
+    queue.replace({"a.gif", "b.gif", "c.gif", "d.gif"});
+
+    QTRY_COMPARE(finished.count(), 4);
+    QCOMPARE(m_server->requested, QStringList({"d.gif", "b.gif", "a.gif", "c.gif"}));
+}
+
+void TestDownloadQueue::dropsDuplicates()
+{
+    DownloadQueue queue(*m_rest, m_directory->path());
+    queue.setMaxConcurrentDownloads(1);
+    QSignalSpy finished(&queue, &DownloadQueue::downloadFinished);
+
+    queue.replace({"a.gif", "b.gif", "a.gif"});
+    QCOMPARE(queue.pendingCount(), 2);
+
+    QTRY_COMPARE(finished.count(), 2);
+    QCOMPARE(m_server->requested, QStringList({"a.gif", "b.gif"}));
+}
+
+void TestDownloadQueue::removesUnwantedPartialDownloads()
+{
+    const QString stale = m_directory->filePath("stale.gif");
+    QFile partial(stale + ".part");
+    QVERIFY(partial.open(QIODevice::WriteOnly));
+    partial.write("da");
+    partial.close();
+    QFile validator(stale + ".part.validator");
+    QVERIFY(validator.open(QIODevice::WriteOnly));
+    validator.write("\"etag\"");
+    validator.close();
+
+    DownloadQueue queue(*m_rest, m_directory->path());
+    QSignalSpy idle(&queue, &DownloadQueue::idle);
+    queue.replace({"a.gif"});
+
+    QVERIFY(!QFile::exists(stale + ".part"));
+    QVERIFY(!QFile::exists(stale + ".part.validator"));
+
+    QTRY_COMPARE(idle.count(), 1);
+    QVERIFY(QFile::exists(m_directory->filePath("a.gif")));
+}
+
+void TestDownloadQueue::cancelAllBecomesIdle()
+{
+    DownloadQueue queue(*m_rest, m_directory->path());
+    queue.setMaxConcurrentDownloads(1);
+    QSignalSpy idle(&queue, &DownloadQueue::idle);
+    QSignalSpy finished(&queue, &DownloadQueue::downloadFinished);
+
+    queue.replace({"a.gif", "b.gif"});
+    queue.cancelAll();
+
+    QCOMPARE(queue.pendingCount(), 0);
+    QCOMPARE(idle.count(), 1);
+    QTest::qWait(100);
+    QCOMPARE(finished.count(), 0);
+}
+
+void TestDownloadQueue::keepsAttemptsWhenTheListIsResent()
+{
+    m_server->missing.insert("bad.gif");
+    DownloadQueue queue(*m_rest, m_directory->path());
+    QSignalSpy failed(&queue, &DownloadQueue::downloadFailed);
+    queue.replace({"bad.gif"});
+
+    // The backend resends the same file list after every attempt; retries back off 2 + 4 + 8 seconds
+    qsizetype seen = 0;
+    QElapsedTimer timer;
+    timer.start();
+    while (failed.isEmpty() && timer.elapsed() < 30000) {
+        if (m_server->requested.size() > seen) {
+            seen = m_server->requested.size();
+            queue.replace({"bad.gif"});
+        }
+        QTest::qWait(50);
+    }
+
+    QCOMPARE(failed.count(), 1);
+    QCOMPARE(m_server->requested.count("bad.gif"), 4);
+    QVERIFY(queue.isIdle());
+}
+
+QTEST_GUILESS_MAIN(TestDownloadQueue)
+#include "tst_downloadqueue.moc"
@@ -0,0 +1,91 @@
+#include "services/media/FrameCache.h"
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace Services::Media;
+
+const QString MEDIA_PATH = QStringLiteral(TEST_MEDIA_DIR "/default.gif");
+const QSize FRAME_SIZE(64, 64);
+constexpr qint64 BUDGET_BYTES = 64 * 1024 * 1024;
+
+class TestFrameCache : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void decodesMissesInTheBackground();
+    void remembersFilesThatCannotBeDecoded();
+    void coalescesStatistics();
+};
+
+void TestFrameCache::decodesMissesInTheBackground()
+{
+    FrameCache cache(BUDGET_BYTES);
+    QSignalSpy ready(&cache, &FrameCache::framesReady);
+
+    QVERIFY(!cache.frames(MEDIA_PATH, FRAME_SIZE));
+    QVERIFY(cache.isPrefetching(MEDIA_PATH, FRAME_SIZE));
+    QCOMPARE(cache.misses(), quint64(1));
+
+    QTRY_COMPARE(ready.count(), 1);
+    QVERIFY(cache.contains(MEDIA_PATH, FRAME_SIZE));
+
+    QSharedPointer<const Frames> frames = cache.frames(MEDIA_PATH, FRAME_SIZE);
+    QVERIFY(frames);
+    QVERIFY(frames->images.size() > 1);
+    QCOMPARE(frames->images.first().size(), FRAME_SIZE);
+    QCOMPARE(cache.hits(), quint64(1));
+    QCOMPARE(cache.bytes(), frames->bytes);
+}
+
+void TestFrameCache::remembersFilesThatCannotBeDecoded()
+{
+    QTemporaryDir directory;
+    const QString path = directory.filePath("corrupt.gif");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("GIF89a, or not");
+    file.close();
+
+    FrameCache cache(BUDGET_BYTES);
+    QSignalSpy ready(&cache, &FrameCache::framesReady);
+
+    QVERIFY(!cache.frames(path, FRAME_SIZE));
+    QTRY_COMPARE(ready.count(), 1);
+
+    // Not decoded again, and a hit from now on
+    QVERIFY(cache.contains(path, FRAME_SIZE));
+    QVERIFY(!cache.frames(path, FRAME_SIZE));
+    QVERIFY(!cache.isPrefetching(path, FRAME_SIZE));
+    cache.prefetch(path, FRAME_SIZE);
+    QVERIFY(!cache.isPrefetching(path, FRAME_SIZE));
+    QCOMPARE(cache.misses(), quint64(1));
+    QCOMPARE(cache.hits(), quint64(1));
+
+    // A new download of the file gets another chance
+    cache.invalidate(path);
+    QVERIFY(!cache.contains(path, FRAME_SIZE));
+}
+
+void TestFrameCache::coalescesStatistics()
+{
+    FrameCache cache(BUDGET_BYTES);
+    QSignalSpy ready(&cache, &FrameCache::framesReady);
+    QSignalSpy statistics(&cache, &FrameCache::statisticsChanged);
+    cache.prefetch(MEDIA_PATH, FRAME_SIZE);
+    QTRY_COMPARE(ready.count(), 1);
+    QTRY_COMPARE(statistics.count(), 1);
+    statistics.clear();
+
+    for (int i = 0; i < 100; ++i) {
+        QVERIFY(cache.frames(MEDIA_PATH, FRAME_SIZE));
+    }
+    QCOMPARE(statistics.count(), 0);
+    QTRY_COMPARE(statistics.count(), 1);
+    QCOMPARE(cache.hits(), quint64(100));
+}
+
+QTEST_MAIN(TestFrameCache)
+#include "tst_framecache.moc"
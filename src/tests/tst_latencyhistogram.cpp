@@ -0,0 +1,94 @@
+#include "services/websocket/LatencyHistogram.h"
+#include <QTest>
+
+using namespace Services::WebSocket;
+
+class TestLatencyHistogram : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void isEmptyInitially();
+    void countsSamplesIntoBuckets();
+    void resolvesPercentilesToBucketBounds();
+    void clampsPercentilesToMax();
+    void countsTimeoutsSeparately();
+};
+
+void TestLatencyHistogram::isEmptyInitially()
+{
+    LatencyHistogram histogram;
+    QCOMPARE(histogram.count(), quint64(0));
+    QCOMPARE(histogram.average(), qint64(0));
+    QCOMPARE(histogram.max(), qint64(0));
+    QCOMPARE(histogram.percentile(0.5), qint64(0));
+}
+
+void TestLatencyHistogram::countsSamplesIntoBuckets()
+{
+    LatencyHistogram histogram;
+    histogram.add(0);
+    histogram.add(10); // Bounds are inclusive
+    histogram.add(11);
+    histogram.add(10000);
+    histogram.add(10001);
+
+    const QVariantMap map = histogram.toVariantMap();
+    const QVariantList buckets = map["buckets"].toList();
+    QCOMPARE(buckets.size(), int(LatencyHistogram::BUCKET_BOUNDS_MS.size()) + 1);
+    QCOMPARE(buckets.at(0).toULongLong(), quint64(2));
+    QCOMPARE(buckets.at(1).toULongLong(), quint64(1));
+    QCOMPARE(buckets.at(buckets.size() - 2).toULongLong(), quint64(1));
+    QCOMPARE(buckets.last().toULongLong(), quint64(1));
+
+    QCOMPARE(histogram.count(), quint64(5));
+    QCOMPARE(histogram.max(), qint64(10001));
+    QCOMPARE(histogram.average(), qint64((0 + 10 + 11 + 10000 + 10001) / 5));
+}
+
+void TestLatencyHistogram::resolvesPercentilesToBucketBounds()
+{
+    LatencyHistogram histogram;
+    for (int i = 0; i < 90; ++i) {
+        histogram.add(5);
+    }
+    for (int i = 0; i < 9; ++i) {
+        histogram.add(200);
+    }
+    histogram.add(20000);
+
+    QCOMPARE(histogram.percentile(0.50), qint64(10));
+    QCOMPARE(histogram.percentile(0.90), qint64(10));
+    QCOMPARE(histogram.percentile(0.95), qint64(250));
+    QCOMPARE(histogram.percentile(0.99), qint64(250));
+    QCOMPARE(histogram.percentile(1.0), qint64(20000)); // Above the last bound
+
+    const QVariantMap map = histogram.toVariantMap();
+    QCOMPARE(map["p50"].toLongLong(), qint64(10));
+    QCOMPARE(map["p95"].toLongLong(), qint64(250));
+    QCOMPARE(map["max"].toLongLong(), qint64(20000));
+}
+
+void TestLatencyHistogram::clampsPercentilesToMax()
+{
+    LatencyHistogram histogram;
+    histogram.add(30);
+    QCOMPARE(histogram.percentile(0.5), qint64(30));
+    QCOMPARE(histogram.percentile(0.99), qint64(30));
+}
+
+void TestLatencyHistogram::countsTimeoutsSeparately()
+{
+    LatencyHistogram histogram;
+    histogram.add(20);
+    histogram.addTimeout();
+    histogram.addTimeout();
+
+    QCOMPARE(histogram.count(), quint64(1));
+    QCOMPARE(histogram.timeouts(), quint64(2));
+    QCOMPARE(histogram.average(), qint64(20));
+    QCOMPARE(histogram.toVariantMap()["timeouts"].toULongLong(), quint64(2));
+}
+
+QTEST_GUILESS_MAIN(TestLatencyHistogram)
+#include "tst_latencyhistogram.moc"
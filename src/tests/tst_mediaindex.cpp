@@ -0,0 +1,211 @@
+#include "services/media/Index.h"
+#include <QCryptographicHash>
+#include <QFile>
+#include <QJsonObject>
+#include <QScopedPointer>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace Services::Media;
+
+const QByteArray DATA_SHA256 = "3a6eb0790f39ac87c94f3856b2dd2c5d110e6811602261a9a923d3bb23adc8b7";
+const QByteArray OTHER_SHA256 = "d9298a10d1b0735837dc4bd85dac641b0f3cef27a47e5d53a54f2f3f5b2fcffa";
+
+class TestMediaIndex : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void init();
+    void cleanup();
+
+    void parsesManifestEntries();
+    void matchesExistingFileWithoutDigests();
+    void doesNotMatchMissingFile();
+    void doesNotMatchOtherSize();
+    void matchesSha256OnceHashed();
+    void skipsHashingFilesOfOtherSize();
+    void ignoresDigestOfReplacedFile();
+    void matchesRecordedEtag();
+    void keepsDigestsAcrossSaveAndLoad();
+    void skipsFileChecksForUnchangedManifest();
+
+  private:
+    void writeFile(const QString& name, const QByteArray& data);
+    Index* createIndex();
+
+    QTemporaryDir* m_directory = nullptr;
+    Index* m_index = nullptr;
+};
+
+void TestMediaIndex::init()
+{
+    m_directory = new QTemporaryDir();
+    QVERIFY(m_directory->isValid());
+    m_index = createIndex();
+}
+
+void TestMediaIndex::cleanup()
+{
+    delete m_index;
+    delete m_directory;
+    m_index = nullptr;
+    m_directory = nullptr;
+}
+
+void TestMediaIndex::writeFile(const QString& name, const QByteArray& data)
+{
+    QFile file(m_directory->filePath(name));
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(data);
+}
+
+Index* TestMediaIndex::createIndex()
+{
+    return new Index(m_directory->path(), m_directory->filePath(".index/media-index.json"));
+}
+
+void TestMediaIndex::parsesManifestEntries()
+{
+    ManifestEntry plain = ManifestEntry::fromJson(QJsonValue("a.gif"));
+    QCOMPARE(plain.name, QStringLiteral("a.gif"));
+    QCOMPARE(plain.size, qint64(-1));
+    QVERIFY(plain.sha256.isEmpty());
+
+    ManifestEntry full = ManifestEntry::fromJson(QJsonObject{
+        {"name", "b.gif"},
+        {"size", 4},
+        {"sha256", QString::fromLatin1(DATA_SHA256).toUpper()},
+        {"etag", "\"b1\""},
+    });
+    QCOMPARE(full.name, QStringLiteral("b.gif"));
+    QCOMPARE(full.size, qint64(4));
+    QCOMPARE(full.sha256, DATA_SHA256);
+    QCOMPARE(full.etag, QStringLiteral("\"b1\""));
+}
+
+void TestMediaIndex::matchesExistingFileWithoutDigests()
+{
+    writeFile("a.gif", "data");
+    QVERIFY(m_index->matches(ManifestEntry{"a.gif"}));
+}
+
+void TestMediaIndex::doesNotMatchMissingFile()
+{
+    QVERIFY(!m_index->matches(ManifestEntry{"a.gif"}));
+    QCOMPARE(m_index->hashRequest("a.gif").size, qint64(-1));
+}
+
+void TestMediaIndex::doesNotMatchOtherSize()
+{
+    writeFile("a.gif", "data");
+    QVERIFY(m_index->matches(ManifestEntry{"a.gif", 4}));
+    QVERIFY(!m_index->matches(ManifestEntry{"a.gif", 5}));
+}
+
+void TestMediaIndex::matchesSha256OnceHashed()
+{
+    writeFile("a.gif", "data");
+    const ManifestEntry entry{"a.gif", 4, DATA_SHA256};
+
+    // The index never hashes by itself
+    QVERIFY(!m_index->matches(entry));
+
+    const QList<Index::HashRequest> requests = m_index->unhashed({entry});
+    QCOMPARE(requests.size(), 1);
+    QCOMPARE(requests.first().name, QStringLiteral("a.gif"));
+    QCOMPARE(requests.first().size, qint64(4));
+
+    m_index->storeSha256(requests.first(), Index::hashFile(requests.first().path));
+    QVERIFY(m_index->matches(entry));
+    QCOMPARE(m_index->cachedSha256("a.gif"), DATA_SHA256);
+    QVERIFY(m_index->unhashed({entry}).isEmpty());
+
+    QVERIFY(!m_index->matches(ManifestEntry{"a.gif", 4, OTHER_SHA256}));
+}
+
+void TestMediaIndex::skipsHashingFilesOfOtherSize()
+{
+    writeFile("a.gif", "data");
+    QVERIFY(m_index->unhashed({ManifestEntry{"a.gif", 5, DATA_SHA256}}).isEmpty());
+    QVERIFY(m_index->unhashed({ManifestEntry{"b.gif", 4, DATA_SHA256}}).isEmpty());
+}
+
+void TestMediaIndex::ignoresDigestOfReplacedFile()
+{
+    writeFile("a.gif", "data");
+    const Index::HashRequest request = m_index->hashRequest("a.gif");
+    QCOMPARE(request.size, qint64(4));
+
+    // Replaced while it was hashed, a different size so the modification time does not matter
+    writeFile("a.gif", "other");
+    m_index->storeSha256(request, DATA_SHA256);
+
+    QVERIFY(m_index->cachedSha256("a.gif").isEmpty());
+    QVERIFY(!m_index->matches(ManifestEntry{"a.gif", -1, DATA_SHA256}));
+}
+
+void TestMediaIndex::matchesRecordedEtag()
+{
+    writeFile("a.gif", "data");
+    QVERIFY(!m_index->matches(ManifestEntry{"a.gif", -1, QByteArray(), "\"a1\""}));
+
+    m_index->record("a.gif", "\"a1\"");
+    QVERIFY(m_index->matches(ManifestEntry{"a.gif", -1, QByteArray(), "\"a1\""}));
+    QVERIFY(!m_index->matches(ManifestEntry{"a.gif", -1, QByteArray(), "\"a2\""}));
+}
+
+void TestMediaIndex::keepsDigestsAcrossSaveAndLoad()
+{
+    writeFile("a.gif", "data");
+    m_index->storeSha256(m_index->hashRequest("a.gif"), DATA_SHA256);
+    m_index->save();
+
+    QScopedPointer<Index> loaded(createIndex());
+    loaded->load();
+    QCOMPARE(loaded->cachedSha256("a.gif"), DATA_SHA256);
+    QVERIFY(loaded->matches(ManifestEntry{"a.gif", 4, DATA_SHA256}));
+}
+
+void TestMediaIndex::skipsFileChecksForUnchangedManifest()
+{
+    const int count = 1000;
+    QList<ManifestEntry> manifest;
+    for (int i = 0; i < count; ++i) {
+        const QString name = QStringLiteral("%1.gif").arg(i);
+        const QByteArray data = QByteArray::number(i);
+        writeFile(name, data);
+        manifest.append(ManifestEntry{name, data.size(), QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex()});
+    }
+
+    // First sync: every file is looked up and hashed once
+    int hashes = 0;
+    for (const Index::HashRequest& request : m_index->unhashed(manifest)) {
+        m_index->storeSha256(request, Index::hashFile(request.path));
+        ++hashes;
+    }
+    QCOMPARE(hashes, count);
+    QVERIFY(m_index->outdated(manifest).isEmpty());
+
+    // Same manifest, same index: neither stats nor hashes
+    const quint64 checks = m_index->fileChecks();
+    QVERIFY(m_index->unhashed(manifest).isEmpty());
+    QVERIFY(m_index->outdated(manifest).isEmpty());
+    QCOMPARE(m_index->fileChecks(), checks);
+
+    // A changed manifest is checked again
+    manifest[0].sha256 = OTHER_SHA256;
+    QCOMPARE(m_index->outdated(manifest), QStringList({"0.gif"}));
+    QVERIFY(m_index->fileChecks() > checks);
+
+    // So is an unchanged manifest against a changed index
+    manifest[0].sha256 = QCryptographicHash::hash("0", QCryptographicHash::Sha256).toHex();
+    QVERIFY(m_index->outdated(manifest).isEmpty());
+    m_index->storeSha256(m_index->hashRequest("1.gif"), manifest[1].sha256);
+    const quint64 stored = m_index->fileChecks();
+    QVERIFY(m_index->outdated(manifest).isEmpty());
+    QVERIFY(m_index->fileChecks() > stored);
+}
+
+QTEST_GUILESS_MAIN(TestMediaIndex)
+#include "tst_mediaindex.moc"
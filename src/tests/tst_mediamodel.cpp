@@ -0,0 +1,263 @@
+#include "services/media/Model.h"
+#include <QSignalSpy>
+#include <QTest>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+using namespace Services::Media;
+
+constexpr int LIBRARY_SIZE = 10000;
+
+namespace
+{
+QList<Item> library(int size)
+{
+    QList<Item> items;
+    items.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        const QString filename = QStringLiteral("%1.gif").arg(i);
+        items.append(Item(filename, "/media/" + filename, 1024));
+    }
+    return items;
+}
+
+/**
+ * The lookup Model used to do: a scan over every row.
+ */
+int linearIndexOf(const QList<Item>& items, const QString& filename)
+{
+    for (int i = 0; i < items.size(); ++i) {
+        if (items[i].filename() == filename) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Bytes of heap in use, -1 where the C library does not tell.
+ */
+qint64 heapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    return qint64(mallinfo2().uordblks);
+#else
+    return -1;
+#endif
+}
+} // namespace
+
+/**
+ * The row type Item replaced: a QObject per file with its own copies of the id and MIME type.
+ */
+class ObjectItem : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString id READ id CONSTANT)
+    Q_PROPERTY(QString filename READ filename CONSTANT)
+    Q_PROPERTY(QString path READ path CONSTANT)
+    Q_PROPERTY(QString type READ type CONSTANT)
+
+  public:
+    ObjectItem(const QString& id, const QString& filename, const QString& path, const QString& type, int size, QObject* parent)
+        : QObject(parent),
+          m_id(id),
+          m_filename(filename),
+          m_path(path),
+          m_type(type),
+          m_size(size),
+          m_isValid(true),
+          m_validated(false)
+    {
+    }
+
+    QString id() const { return m_id; }
+    QString filename() const { return m_filename; }
+    QString path() const { return m_path; }
+    QString type() const { return m_type; }
+
+  private:
+    QString m_id;
+    QString m_filename;
+    QString m_path;
+    QString m_type;
+    int m_size;
+    bool m_isValid;
+    bool m_validated;
+    Validation m_validation;
+};
+
+class TestMediaModel : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+
+    void findsRowsByFilename();
+    void reindexesAfterRemoval();
+    void insertsBatchAtOnce();
+
+    // A sync looks up every file of the server list in the model
+    void syncLookupLinear();
+    void syncLookupIndexed();
+    void insertOneByOne();
+    void insertBatch();
+
+    // Heap per row of a library, reported as bytes allocated per item
+    void memoryPerObjectItem();
+    void memoryPerValueItem();
+
+  private:
+    qint64 objectItemBytes() const;
+    qint64 valueItemBytes() const;
+
+    QList<Item> m_library;
+    QStringList m_serverFiles;
+};
+
+void TestMediaModel::initTestCase()
+{
+    m_library = library(LIBRARY_SIZE);
+    for (const Item& item : std::as_const(m_library)) {
+        m_serverFiles.append(item.filename());
+    }
+}
+
+void TestMediaModel::findsRowsByFilename()
+{
+    Model model;
+    model.setMedia(library(3));
+
+    QCOMPARE(model.indexOf("1.gif"), 1);
+    QVERIFY(model.contains("2.gif"));
+    QVERIFY(!model.contains("3.gif"));
+    QCOMPARE(model.getPath("0.gif"), QStringLiteral("/media/0.gif"));
+    QVERIFY(model.getPath("3.gif").isEmpty());
+}
+
+void TestMediaModel::reindexesAfterRemoval()
+{
+    Model model;
+    model.setMedia(library(3));
+
+    model.removeItem("0.gif");
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(model.indexOf("0.gif"), -1);
+    QCOMPARE(model.indexOf("1.gif"), 0);
+    QCOMPARE(model.indexOf("2.gif"), 1);
+    QCOMPARE(model.get(1).filename(), QStringLiteral("2.gif"));
+}
+
+void TestMediaModel::insertsBatchAtOnce()
+{
+    Model model;
+    model.addItem(Item("a.gif", "/media/a.gif", 1));
+    QSignalSpy inserted(&model, &Model::rowsInserted);
+    QSignalSpy count(&model, &Model::countChanged);
+
+    model.addItems({Item("b.gif", "/media/b.gif", 1), Item("a.gif", "/media/a.gif", 1), Item("c.gif", "/media/c.gif", 1),
+                    Item("b.gif", "/media/b.gif", 1)});
+
+    QCOMPARE(inserted.count(), 1);
+    QCOMPARE(inserted.first().at(1).toInt(), 1);
+    QCOMPARE(inserted.first().at(2).toInt(), 2);
+    QCOMPARE(count.count(), 1);
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.indexOf("c.gif"), 2);
+}
+
+void TestMediaModel::syncLookupLinear()
+{
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QString& filename : std::as_const(m_serverFiles)) {
+            found += linearIndexOf(m_library, filename) >= 0 ? 1 : 0;
+        }
+    }
+    QCOMPARE(found, LIBRARY_SIZE);
+}
+
+void TestMediaModel::syncLookupIndexed()
+{
+    Model model;
+    model.setMedia(m_library);
+
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QString& filename : std::as_const(m_serverFiles)) {
+            found += model.contains(filename) ? 1 : 0;
+        }
+    }
+    QCOMPARE(found, LIBRARY_SIZE);
+}
+
+void TestMediaModel::insertOneByOne()
+{
+    QBENCHMARK {
+        Model model;
+        for (const Item& item : std::as_const(m_library)) {
+            model.addItem(item);
+        }
+    }
+}
+
+void TestMediaModel::insertBatch()
+{
+    QBENCHMARK {
+        Model model;
+        model.addItems(m_library);
+    }
+}
+
+qint64 TestMediaModel::objectItemBytes() const
+{
+    const qint64 before = heapInUse();
+    QObject model;
+    QList<ObjectItem*> items;
+    for (const QString& file : m_serverFiles) {
+        // As the media service built them, with the type string assigned per item
+        QString type = "unknown";
+        type = "image/gif";
+        items.append(new ObjectItem(file, file, "/media/" + file, type, 1024, &model));
+    }
+    return (heapInUse() - before) / LIBRARY_SIZE;
+}
+
+qint64 TestMediaModel::valueItemBytes() const
+{
+    const qint64 before = heapInUse();
+    Model model;
+    {
+        QList<Item> items;
+        for (const QString& file : m_serverFiles) {
+            items.append(Item(file, "/media/" + file, 1024));
+        }
+        model.addItems(items);
+    }
+    return (heapInUse() - before) / LIBRARY_SIZE;
+}
+
+void TestMediaModel::memoryPerObjectItem()
+{
+    if (heapInUse() < 0) {
+        QSKIP("Heap statistics need glibc 2.33 or later");
+    }
+    QTest::setBenchmarkResult(objectItemBytes(), QTest::BytesAllocated);
+}
+
+void TestMediaModel::memoryPerValueItem()
+{
+    if (heapInUse() < 0) {
+        QSKIP("Heap statistics need glibc 2.33 or later");
+    }
+    const qint64 bytes = valueItemBytes();
+    QVERIFY(bytes < objectItemBytes());
+    QTest::setBenchmarkResult(bytes, QTest::BytesAllocated);
+}
+
+QTEST_GUILESS_MAIN(TestMediaModel)
+#include "tst_mediamodel.moc"
@@ -0,0 +1,122 @@
+#include "services/websocket/Outbox.h"
+#include <QFile>
+#include <QScopedPointer>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace Services::WebSocket;
+
+class TestOutbox : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void init();
+    void cleanup();
+
+    void keepsLatestPublishPerTopic();
+    void isBounded();
+    void survivesRestart();
+    void batchesWrites();
+    void removesFileWhenFlushed();
+
+  private:
+    QString filePath() const;
+
+    QTemporaryDir* m_directory = nullptr;
+};
+
+void TestOutbox::init()
+{
+    m_directory = new QTemporaryDir();
+    QVERIFY(m_directory->isValid());
+}
+
+void TestOutbox::cleanup()
+{
+    delete m_directory;
+    m_directory = nullptr;
+}
+
+QString TestOutbox::filePath() const
+{
+    return m_directory->filePath("bee/websocket-outbox.json");
+}
+
+void TestOutbox::keepsLatestPublishPerTopic()
+{
+    Outbox outbox(filePath());
+    outbox.put(Topic::ApplicationStatus, QJsonObject{{"status", 1}});
+    outbox.put(Topic::Media, QJsonObject{{"files", 3}});
+    outbox.put(Topic::ApplicationStatus, QJsonObject{{"status", 2}});
+
+    const QList<Outbox::Entry> entries = outbox.takeAll();
+    QCOMPARE(entries.size(), 2);
+    QCOMPARE(entries.at(0).topic, Topic::Media);
+    QCOMPARE(entries.at(1).topic, Topic::ApplicationStatus);
+    QCOMPARE(entries.at(1).params["status"].toInt(), 2);
+    QVERIFY(outbox.isEmpty());
+}
+
+void TestOutbox::isBounded()
+{
+    // A flood of publishes during an outage keeps one entry per topic
+    Outbox outbox(filePath());
+    for (int i = 0; i < 1000; ++i) {
+        outbox.put(Topic::ApplicationStatus, QJsonObject{{"status", i}});
+        outbox.put(Topic::Configuration, QJsonObject{{"version", i}});
+    }
+    QCOMPARE(outbox.size(), 2);
+}
+
+void TestOutbox::survivesRestart()
+{
+    {
+        Outbox outbox(filePath());
+        outbox.put(Topic::ApplicationStatus, QJsonObject{{"status", 1}});
+        outbox.put(Topic::Configuration, QJsonObject{{"version", 7}});
+        // Destroyed before the batch was written, as on a regular shutdown
+    }
+
+    Outbox restarted(filePath());
+    restarted.load();
+    const QList<Outbox::Entry> entries = restarted.takeAll();
+    QCOMPARE(entries.size(), 2);
+    QCOMPARE(entries.at(0).topic, Topic::ApplicationStatus);
+    QCOMPARE(entries.at(0).params["status"].toInt(), 1);
+    QCOMPARE(entries.at(1).topic, Topic::Configuration);
+    QCOMPARE(entries.at(1).params["version"].toInt(), 7);
+}
+
+void TestOutbox::batchesWrites()
+{
+    Outbox outbox(filePath());
+    for (int i = 0; i < 100; ++i) {
+        outbox.put(Topic::ApplicationStatus, QJsonObject{{"status", i}});
+    }
+
+    // Nothing hits the flash until the batch interval passed, then a single write
+    QVERIFY(!QFile::exists(filePath()));
+    QTRY_VERIFY_WITH_TIMEOUT(QFile::exists(filePath()), 10000);
+
+    Outbox restarted(filePath());
+    restarted.load();
+    QCOMPARE(restarted.size(), 1);
+}
+
+void TestOutbox::removesFileWhenFlushed()
+{
+    {
+        Outbox outbox(filePath());
+        outbox.put(Topic::ApplicationStatus, QJsonObject{{"status", 1}});
+    }
+    QVERIFY(QFile::exists(filePath()));
+
+    Outbox restarted(filePath());
+    restarted.load();
+    QCOMPARE(restarted.takeAll().size(), 1);
+    QVERIFY(!QFile::exists(filePath()));
+}
+
+QTEST_GUILESS_MAIN(TestOutbox)
+#include "tst_outbox.moc"
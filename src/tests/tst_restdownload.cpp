@@ -0,0 +1,343 @@
+#include "drivers/network/Driver.h"
+#include "services/rest/Service.h"
+#include <QFile>
+#include <QSharedPointer>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTest>
+
+/**
+ * HTTP stand-in for the media endpoint of the backend, serving a single resource.
+ * Honours Range requests guarded by If-Range against the ETag of the resource, and can
+ * misbehave: drop the connection halfway through the body, or ignore If-Range.
+ */
+class ResourceServer : public QObject
+{
+  public:
+    struct Request
+    {
+        QByteArray range;
+        QByteArray ifRange;
+    };
+
+    ResourceServer()
+    {
+        connect(&m_server, &QTcpServer::newConnection, this, &ResourceServer::onNewConnection);
+        m_server.listen(QHostAddress::LocalHost);
+    }
+
+    QString url() const
+    {
+        return QStringLiteral("http://127.0.0.1:%1").arg(m_server.serverPort());
+    }
+
+    QByteArray content;
+    QByteArray etag;
+    qint64 dropAfter = -1;      // Body bytes sent before the connection is dropped, -1 for all
+    bool ignoreIfRange = false; // Answers a Range request with 206 even when the resource changed
+    QList<Request> requests;
+
+  private:
+    void onNewConnection()
+    {
+        while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+            connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+                if (!socket->peek(socket->bytesAvailable()).contains("\r\n\r\n")) {
+                    return; // Headers not complete yet
+                }
+                respond(socket, socket->readAll());
+            });
+        }
+    }
+
+    void respond(QTcpSocket* socket, const QByteArray& request)
+    {
+        Request received;
+        const QList<QByteArray> lines = request.split('\n');
+        for (const QByteArray& line : lines) {
+            const qsizetype colon = line.indexOf(':');
+            const QByteArray name = line.left(colon).trimmed().toLower();
+            if (name == "range") {
+                received.range = line.mid(colon + 1).trimmed();
+            }
+            else if (name == "if-range") {
+                received.ifRange = line.mid(colon + 1).trimmed();
+            }
+        }
+        requests.append(received);
+
+        qint64 start = 0;
+        bool partial = false;
+        if (received.range.startsWith("bytes=")) {
+            start = received.range.mid(6, received.range.indexOf('-') - 6).toLongLong();
+            partial = received.ifRange.isEmpty() || received.ifRange == etag || ignoreIfRange;
+        }
+
+        if (partial && start >= content.size()) {
+            socket->write("HTTP/1.1 416 Range Not Satisfiable\r\nContent-Range: bytes */" + QByteArray::number(content.size()) +
+                          "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+            socket->disconnectFromHost();
+            return;
+        }
+
+        const QByteArray body = partial ? content.mid(start) : content;
+        QByteArray response = partial ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n";
+        response += "ETag: " + etag + "\r\n";
+        response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+        if (partial) {
+            response += "Content-Range: bytes " + QByteArray::number(start) + "-" + QByteArray::number(content.size() - 1) + "/" +
+                        QByteArray::number(content.size()) + "\r\n";
+        }
+        response += "Connection: close\r\n\r\n";
+        response += dropAfter >= 0 ? body.left(dropAfter) : body;
+
+        socket->write(response);
+        socket->disconnectFromHost();
+    }
+
+    QTcpServer m_server;
+};
+
+namespace
+{
+struct Result
+{
+    bool done = false;
+    bool success = false;
+    QString filePath;
+    QString error;
+};
+
+QByteArray resource(int size, char first)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i) {
+        data[i] = char(first + i % 26);
+    }
+    return data;
+}
+
+QByteArray readFile(const QString& path)
+{
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+void writeFile(const QString& path, const QByteArray& data)
+{
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        file.write(data);
+    }
+}
+} // namespace
+
+class TestRestDownload : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void renamesOnlyOnCompletion();
+    void keepsPartialFileWhenConnectionDrops();
+    void resumesPartialFile();
+    void restartsWhenResourceChanged();
+    void discardsPartialFileOnValidatorMismatch();
+    void restartsWithoutValidator();
+    void removesPartialFileOnRangeNotSatisfiable();
+
+  private:
+    QSharedPointer<Result> download();
+    QString partialPath() const;
+    QString validatorPath() const;
+
+    Drivers::Network::Driver* m_network = nullptr;
+    Services::Rest::Service* m_rest = nullptr;
+    ResourceServer* m_server = nullptr;
+    QTemporaryDir* m_directory = nullptr;
+    QString m_filePath;
+};
+
+void TestRestDownload::initTestCase()
+{
+    // Keeps the server url out of the settings of the application
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void TestRestDownload::init()
+{
+    m_network = new Drivers::Network::Driver();
+    if (!m_network->loopbackInterfaceConnected()) {
+        QSKIP("The loopback interface is not up");
+    }
+
+    m_server = new ResourceServer();
+    m_server->content = resource(1000, 'a');
+    m_server->etag = "\"v1\"";
+    m_rest = new Services::Rest::Service(*m_network);
+    m_rest->setServerUrl(m_server->url());
+    m_directory = new QTemporaryDir();
+    QVERIFY(m_directory->isValid());
+    m_filePath = m_directory->filePath("a.gif");
+}
+
+void TestRestDownload::cleanup()
+{
+    delete m_directory;
+    delete m_rest;
+    delete m_server;
+    delete m_network;
+    m_directory = nullptr;
+    m_rest = nullptr;
+    m_server = nullptr;
+    m_network = nullptr;
+}
+
+QSharedPointer<Result> TestRestDownload::download()
+{
+    auto result = QSharedPointer<Result>::create();
+    m_rest->downloadToFile("media/a.gif", m_filePath, [result](bool success, const QString& filePath, const QString& error) {
+        result->done = true;
+        result->success = success;
+        result->filePath = filePath;
+        result->error = error;
+    });
+    return result;
+}
+
+QString TestRestDownload::partialPath() const
+{
+    return m_filePath + ".part";
+}
+
+QString TestRestDownload::validatorPath() const
+{
+    return m_filePath + ".part.validator";
+}
+
+void TestRestDownload::renamesOnlyOnCompletion()
+{
+    auto result = QSharedPointer<Result>::create();
+    bool finalFileDuringTransfer = false;
+    m_rest->downloadToFile("media/a.gif", m_filePath, [result](bool success, const QString& filePath, const QString& error) {
+        result->done = true;
+        result->success = success;
+        result->filePath = filePath;
+        result->error = error;
+    }, [this, &finalFileDuringTransfer](qint64, qint64) {
+        finalFileDuringTransfer = finalFileDuringTransfer || QFile::exists(m_filePath);
+    });
+    QTRY_VERIFY(result->done);
+
+    QVERIFY2(result->success, qPrintable(result->error));
+    QVERIFY(!finalFileDuringTransfer);
+    QCOMPARE(result->filePath, m_filePath);
+    QCOMPARE(readFile(m_filePath), m_server->content);
+    QVERIFY(!QFile::exists(partialPath()));
+    QVERIFY(!QFile::exists(validatorPath()));
+}
+
+void TestRestDownload::keepsPartialFileWhenConnectionDrops()
+{
+    m_server->dropAfter = 400;
+    QSharedPointer<Result> result = download();
+    QTRY_VERIFY(result->done);
+
+    QVERIFY(!result->success);
+    QVERIFY(!QFile::exists(m_filePath));
+    QCOMPARE(readFile(partialPath()), m_server->content.left(400));
+    QCOMPARE(readFile(validatorPath()), m_server->etag);
+}
+
+void TestRestDownload::resumesPartialFile()
+{
+    m_server->dropAfter = 400;
+    QSharedPointer<Result> dropped = download();
+    QTRY_VERIFY(dropped->done);
+
+    m_server->dropAfter = -1;
+    QSharedPointer<Result> result = download();
+    QTRY_VERIFY(result->done);
+    QVERIFY2(result->success, qPrintable(result->error));
+
+    QCOMPARE(m_server->requests.size(), 2);
+    QCOMPARE(m_server->requests.last().range, QByteArray("bytes=400-"));
+    QCOMPARE(m_server->requests.last().ifRange, m_server->etag);
+    QCOMPARE(readFile(m_filePath), m_server->content);
+    QVERIFY(!QFile::exists(partialPath()));
+    QVERIFY(!QFile::exists(validatorPath()));
+}
+
+void TestRestDownload::restartsWhenResourceChanged()
+{
+    m_server->dropAfter = 400;
+    QSharedPointer<Result> dropped = download();
+    QTRY_VERIFY(dropped->done);
+
+    // If-Range no longer matches, the server sends the whole new version with a 200
+    m_server->dropAfter = -1;
+    m_server->content = resource(800, 'A');
+    m_server->etag = "\"v2\"";
+    QSharedPointer<Result> result = download();
+    QTRY_VERIFY(result->done);
+    QVERIFY2(result->success, qPrintable(result->error));
+
+    QCOMPARE(m_server->requests.last().ifRange, QByteArray("\"v1\""));
+    QCOMPARE(readFile(m_filePath), m_server->content);
+}
+
+void TestRestDownload::discardsPartialFileOnValidatorMismatch()
+{
+    m_server->dropAfter = 400;
+    QSharedPointer<Result> dropped = download();
+    QTRY_VERIFY(dropped->done);
+
+    // A server that ignores If-Range would append the new version to the old bytes
+    m_server->dropAfter = -1;
+    m_server->ignoreIfRange = true;
+    m_server->content = resource(1000, 'A');
+    m_server->etag = "\"v2\"";
+    QSharedPointer<Result> result = download();
+    QTRY_VERIFY(result->done);
+
+    QVERIFY(!result->success);
+    QVERIFY(!QFile::exists(m_filePath));
+    QVERIFY(!QFile::exists(partialPath()));
+    QVERIFY(!QFile::exists(validatorPath()));
+}
+
+void TestRestDownload::restartsWithoutValidator()
+{
+    writeFile(partialPath(), m_server->content.left(400));
+
+    QSharedPointer<Result> result = download();
+    QTRY_VERIFY(result->done);
+    QVERIFY2(result->success, qPrintable(result->error));
+
+    QVERIFY(m_server->requests.last().range.isEmpty());
+    QCOMPARE(readFile(m_filePath), m_server->content);
+}
+
+void TestRestDownload::removesPartialFileOnRangeNotSatisfiable()
+{
+    writeFile(partialPath(), resource(1200, 'a'));
+    writeFile(validatorPath(), m_server->etag);
+
+    QSharedPointer<Result> result = download();
+    QTRY_VERIFY(result->done);
+
+    QVERIFY(!result->success);
+    QCOMPARE(m_server->requests.last().range, QByteArray("bytes=1200-"));
+    QVERIFY(!QFile::exists(m_filePath));
+    QVERIFY(!QFile::exists(partialPath()));
+    QVERIFY(!QFile::exists(validatorPath()));
+}
+
+QTEST_GUILESS_MAIN(TestRestDownload)
+#include "tst_restdownload.moc"
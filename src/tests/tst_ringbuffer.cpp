@@ -0,0 +1,205 @@
+#include "services/logging/RingBuffer.h"
+#include <QTest>
+#include <QThread>
+#include <atomic>
+#include <memory>
+
+using namespace Services::Logging;
+
+class TestRingBuffer : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void readsWrittenEntries();
+    void doesNotReadUnwrittenEntries();
+    void truncatesLongFields();
+    void overwritesOldestEntries();
+    void readsConsistentEntriesWhileWriting();
+    void dropsWriteThatLapsAnUnfinishedOne();
+    void dropsStalledWriteOfAnEarlierLap();
+};
+
+void TestRingBuffer::readsWrittenEntries()
+{
+    // Too large for the stack
+    auto buffer = std::make_unique<RingBuffer>();
+    buffer->write(Level::Info, "bee.test", "first");
+    buffer->write(Level::Warning, nullptr, "second");
+
+    QCOMPARE(buffer->head(), quint64(2));
+    QCOMPARE(buffer->tail(), quint64(0));
+
+    Entry entry;
+    QVERIFY(buffer->read(0, entry));
+    QCOMPARE(entry.level, Level::Info);
+    QCOMPARE(entry.categoryString(), QStringLiteral("bee.test"));
+    QCOMPARE(entry.messageString(), QStringLiteral("first"));
+    QVERIFY(entry.timestampMs > 0);
+
+    QVERIFY(buffer->read(1, entry));
+    QCOMPARE(entry.level, Level::Warning);
+    QVERIFY(entry.categoryString().isEmpty());
+    QCOMPARE(entry.messageString(), QStringLiteral("second"));
+}
+
+void TestRingBuffer::doesNotReadUnwrittenEntries()
+{
+    auto buffer = std::make_unique<RingBuffer>();
+    Entry entry;
+    QVERIFY(!buffer->read(0, entry));
+
+    buffer->write(Level::Debug, "bee.test", "only");
+    QVERIFY(!buffer->read(1, entry));
+    QVERIFY(!buffer->read(RingBuffer::CAPACITY, entry)); // Same slot as 0
+}
+
+void TestRingBuffer::truncatesLongFields()
+{
+    auto buffer = std::make_unique<RingBuffer>();
+    const QByteArray category(Entry::CATEGORY_LENGTH + 8, 'c');
+    const QString message(Entry::MESSAGE_LENGTH + 50, 'm');
+    buffer->write(Level::Info, category.constData(), message);
+
+    Entry entry;
+    QVERIFY(buffer->read(0, entry));
+    QCOMPARE(entry.categoryString(), QString(Entry::CATEGORY_LENGTH, 'c'));
+    QCOMPARE(entry.messageString(), QString(Entry::MESSAGE_LENGTH, 'm'));
+}
+
+void TestRingBuffer::overwritesOldestEntries()
+{
+    auto buffer = std::make_unique<RingBuffer>();
+    const int written = RingBuffer::CAPACITY + 10;
+    for (int i = 0; i < written; ++i) {
+        buffer->write(Level::Info, "bee.test", QString::number(i));
+    }
+
+    QCOMPARE(buffer->head(), quint64(written));
+    QCOMPARE(buffer->tail(), quint64(10));
+
+    Entry entry;
+    for (quint64 sequence = 0; sequence < 10; ++sequence) {
+        QVERIFY(!buffer->read(sequence, entry));
+    }
+    QVERIFY(buffer->read(10, entry));
+    QCOMPARE(entry.messageString(), QStringLiteral("10"));
+    QVERIFY(buffer->read(written - 1, entry));
+    QCOMPARE(entry.messageString(), QString::number(written - 1));
+}
+
+void TestRingBuffer::readsConsistentEntriesWhileWriting()
+{
+    constexpr int WRITERS = 4;
+    constexpr int ENTRIES_PER_WRITER = 20000;
+    static const char* CATEGORIES[WRITERS] = {"writer0", "writer1", "writer2", "writer3"};
+
+    auto buffer = std::make_unique<RingBuffer>();
+    std::atomic<int> running(WRITERS);
+
+    QList<QThread*> writers;
+    for (int writer = 0; writer < WRITERS; ++writer) {
+        writers.append(QThread::create([&buffer, &running, writer]() {
+            for (int i = 0; i < ENTRIES_PER_WRITER; ++i) {
+                buffer->write(Level::Info, CATEGORIES[writer], QStringLiteral("writer%1 entry %2").arg(writer).arg(i));
+            }
+            --running;
+        }));
+    }
+    for (QThread* thread : writers) {
+        thread->start();
+    }
+
+    // Every entry that reads successfully must be complete, never a mix of two writes
+    quint64 read = 0;
+    quint64 torn = 0;
+    Entry entry;
+    while (running.load() > 0) {
+        const quint64 head = buffer->head();
+        for (quint64 sequence = buffer->tail(); sequence < head; ++sequence) {
+            if (!buffer->read(sequence, entry)) {
+                continue;
+            }
+            ++read;
+            if (!entry.messageString().startsWith(entry.categoryString() + " entry ")) {
+                ++torn;
+            }
+        }
+    }
+
+    for (QThread* thread : writers) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+
+    QCOMPARE(buffer->head(), quint64(WRITERS * ENTRIES_PER_WRITER));
+    QVERIFY(read > 0);
+    QCOMPARE(torn, quint64(0));
+}
+
+void TestRingBuffer::dropsWriteThatLapsAnUnfinishedOne()
+{
+    constexpr int WRITERS = 4;
+    auto buffer = std::make_unique<RingBuffer>();
+
+    // A writer takes sequence 0, claims its slot and stalls before the entry is complete
+    const quint64 stalled = buffer->m_head.fetch_add(1);
+    auto& slot = buffer->m_slots[stalled % RingBuffer::CAPACITY];
+    slot.entry.timestampMs = 0;
+    slot.state.store(stalled * 2 + 1);
+
+    // Meanwhile the other writers go round once, the last of them lands on the stalled slot
+    QList<QThread*> writers;
+    for (int writer = 0; writer < WRITERS; ++writer) {
+        writers.append(QThread::create([&buffer]() {
+            for (int i = 0; i < RingBuffer::CAPACITY / WRITERS; ++i) {
+                buffer->write(Level::Info, "bee.test", QStringLiteral("lap"));
+            }
+        }));
+    }
+    for (QThread* thread : writers) {
+        thread->start();
+    }
+    for (QThread* thread : writers) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+
+    const quint64 lapping = stalled + RingBuffer::CAPACITY;
+    QCOMPARE(buffer->head(), lapping + 1);
+    QCOMPARE(buffer->dropped(), quint64(1));
+    QCOMPARE(slot.state.load(), stalled * 2 + 1);
+    QCOMPARE(slot.entry.timestampMs, qint64(0)); // Left alone for the stalled writer
+
+    Entry entry;
+    QVERIFY(!buffer->read(lapping, entry));
+    for (quint64 sequence = buffer->tail(); sequence < lapping; ++sequence) {
+        QVERIFY(buffer->read(sequence, entry));
+        QCOMPARE(entry.messageString(), QStringLiteral("lap"));
+    }
+}
+
+void TestRingBuffer::dropsStalledWriteOfAnEarlierLap()
+{
+    auto buffer = std::make_unique<RingBuffer>();
+
+    // A writer takes sequence 0 and stalls before it claims the slot, until a later lap completed it
+    const quint64 stalled = buffer->m_head.fetch_add(1);
+    for (int i = 0; i < RingBuffer::CAPACITY; ++i) {
+        buffer->write(Level::Info, "bee.test", QString::number(i + 1));
+    }
+    const quint64 head = buffer->head();
+
+    // Resumes with the sequence it took back then
+    buffer->m_head.store(stalled);
+    buffer->write(Level::Info, "bee.test", "late");
+    buffer->m_head.store(head);
+
+    QCOMPARE(buffer->dropped(), quint64(1));
+    Entry entry;
+    QVERIFY(buffer->read(stalled + RingBuffer::CAPACITY, entry));
+    QCOMPARE(entry.messageString(), QString::number(RingBuffer::CAPACITY));
+}
+
+QTEST_GUILESS_MAIN(TestRingBuffer)
+#include "tst_ringbuffer.moc"
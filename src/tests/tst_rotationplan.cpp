@@ -0,0 +1,166 @@
+#include "applications/common/Application.h"
+#include "applications/common/Configuration.h"
+#include "applications/watchface/RotationPlan.h"
+#include <QTest>
+
+using Applications::Watchface::RotationPlan;
+
+constexpr int MSECS_PER_HOUR = 60 * 60 * 1000;
+
+/**
+ * Application with only the common configuration, which is all the rotation plan looks at.
+ */
+class TestApplication : public Common::Application
+{
+  public:
+    TestApplication(const QString& id, int weight = 1, const QTime& activeFrom = QTime(), const QTime& activeUntil = QTime())
+        : Common::Application(id, Common::Type::Clock, id, 0, Common::Watchface::AnalogClock),
+          m_configuration(new Common::Configuration(id, this))
+    {
+        m_configuration->setWeight(weight);
+        m_configuration->setActiveFrom(activeFrom);
+        m_configuration->setActiveUntil(activeUntil);
+    }
+
+    void applyConfiguration(const QJsonObject& config) override
+    {
+        m_configuration->fromJson(config);
+    }
+
+    Common::Configuration* configuration() const override
+    {
+        return m_configuration;
+    }
+
+  private:
+    Common::Configuration* m_configuration;
+};
+
+namespace
+{
+QStringList slotIds(const RotationPlan& plan)
+{
+    QStringList ids;
+    for (int i = 0; i < plan.size(); ++i) {
+        ids.append(plan.slot(i).app->id());
+    }
+    return ids;
+}
+} // namespace
+
+class TestRotationPlan : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void handlesEmptyPlan();
+    void keepsOrderOfEqualWeights();
+    void spreadsHeavierWatchfaces();
+    void clampsWeightsAndDwellTimes();
+    void skipsWatchfacesOutsideTheirWindow();
+    void showsEveryWatchfaceWhenNoneIsInItsWindow();
+    void wrapsWindowsPastMidnight();
+    void findsNextWindowChange();
+};
+
+void TestRotationPlan::handlesEmptyPlan()
+{
+    RotationPlan plan(QList<Common::Application*>{});
+    QVERIFY(plan.isEmpty());
+    QCOMPARE(plan.step(0, 1, QTime(12, 0)), -1);
+    QCOMPARE(plan.eligibleCount(QTime(12, 0)), 0);
+    QCOMPARE(plan.msecsToNextWindowChange(QTime(12, 0)), qint64(-1));
+}
+
+void TestRotationPlan::keepsOrderOfEqualWeights()
+{
+    TestApplication a("a"), b("b"), c("c");
+    RotationPlan plan({&a, &b, &c});
+
+    QCOMPARE(slotIds(plan), QStringList({"a", "b", "c"}));
+    QCOMPARE(plan.step(2, 1, QTime(12, 0)), 0);
+    QCOMPARE(plan.step(0, -1, QTime(12, 0)), 2);
+    QCOMPARE(plan.eligibleCount(QTime(12, 0)), 3);
+    QCOMPARE(plan.msecsToNextWindowChange(QTime(12, 0)), qint64(-1));
+}
+
+void TestRotationPlan::spreadsHeavierWatchfaces()
+{
+    TestApplication a("a", 3), b("b"), c("c");
+    RotationPlan plan({&a, &b, &c});
+
+    QCOMPARE(slotIds(plan), QStringList({"a", "b", "a", "c", "a"}));
+    QCOMPARE(plan.eligibleCount(QTime(12, 0)), 3);
+}
+
+void TestRotationPlan::clampsWeightsAndDwellTimes()
+{
+    TestApplication light("light", 0), heavy("heavy", 50);
+    light.configuration()->setDwellTime(1);
+    heavy.configuration()->setDwellTime(30);
+    RotationPlan plan({&light, &heavy});
+
+    QCOMPARE(plan.size(), 11);
+    QCOMPARE(slotIds(plan).count("light"), 1);
+
+    const int lightIndex = slotIds(plan).indexOf("light");
+    QCOMPARE(plan.slot(lightIndex).dwellMs, 2000);
+    QCOMPARE(plan.slot(lightIndex == 0 ? 1 : 0).dwellMs, 30000);
+}
+
+void TestRotationPlan::skipsWatchfacesOutsideTheirWindow()
+{
+    TestApplication always("always"), morning("morning", 1, QTime(8, 0), QTime(12, 0));
+    RotationPlan plan({&always, &morning});
+
+    QCOMPARE(plan.step(0, 1, QTime(9, 0)), 1);
+    QCOMPARE(plan.eligibleCount(QTime(9, 0)), 2);
+
+    // Only watchface left, steps back to itself
+    QCOMPARE(plan.step(0, 1, QTime(13, 0)), 0);
+    QCOMPARE(plan.step(0, -1, QTime(13, 0)), 0);
+    QCOMPARE(plan.eligibleCount(QTime(13, 0)), 1);
+
+    // The window ends at, not after, its until time
+    QCOMPARE(plan.eligibleCount(QTime(12, 0)), 1);
+    QCOMPARE(plan.eligibleCount(QTime(8, 0)), 2);
+}
+
+void TestRotationPlan::showsEveryWatchfaceWhenNoneIsInItsWindow()
+{
+    TestApplication early("early", 1, QTime(8, 0), QTime(9, 0)), late("late", 1, QTime(10, 0), QTime(11, 0));
+    RotationPlan plan({&early, &late});
+
+    QCOMPARE(plan.eligibleCount(QTime(12, 0)), 2);
+    QCOMPARE(plan.step(0, 1, QTime(12, 0)), 1);
+
+    QCOMPARE(plan.eligibleCount(QTime(8, 30)), 1);
+    QCOMPARE(plan.step(0, 1, QTime(8, 30)), 0);
+}
+
+void TestRotationPlan::wrapsWindowsPastMidnight()
+{
+    TestApplication night("night", 1, QTime(22, 0), QTime(6, 0)), day("day", 1, QTime(6, 0), QTime(22, 0));
+    RotationPlan plan({&night, &day});
+
+    QCOMPARE(plan.step(1, 1, QTime(23, 0)), 0);
+    QCOMPARE(plan.step(0, 1, QTime(23, 0)), 0);
+    QCOMPARE(plan.step(0, 1, QTime(3, 0)), 0);
+    QCOMPARE(plan.step(0, 1, QTime(12, 0)), 1);
+    QCOMPARE(plan.eligibleCount(QTime(5, 59)), 1);
+}
+
+void TestRotationPlan::findsNextWindowChange()
+{
+    TestApplication always("always"), morning("morning", 1, QTime(8, 0), QTime(12, 0));
+    RotationPlan plan({&always, &morning});
+
+    QCOMPARE(plan.msecsToNextWindowChange(QTime(7, 0)), qint64(1 * MSECS_PER_HOUR));
+    QCOMPARE(plan.msecsToNextWindowChange(QTime(9, 30)), qint64(2.5 * MSECS_PER_HOUR));
+
+    // A boundary right now is not a change to wait for
+    QCOMPARE(plan.msecsToNextWindowChange(QTime(12, 0)), qint64(20 * MSECS_PER_HOUR));
+}
+
+QTEST_GUILESS_MAIN(TestRotationPlan)
+#include "tst_rotationplan.moc"
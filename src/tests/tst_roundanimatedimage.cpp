@@ -0,0 +1,118 @@
+#include "qmlcomponents/RoundAnimatedImage.h"
+#include <QFile>
+#include <QMovie>
+#include <QPainter>
+#include <QPainterPath>
+#include <QQuickPaintedItem>
+#include <QQuickWindow>
+#include <QTest>
+
+const QString MEDIA_PATH = QStringLiteral(TEST_MEDIA_DIR "/default.gif");
+constexpr int IMAGE_SIZE = 480;
+
+/**
+ * The QQuickPaintedItem implementation RoundAnimatedImage replaced: QMovie decodes every frame,
+ * which is then clipped, scaled and drawn on the CPU.
+ */
+class PainterRoundAnimatedImage : public QQuickPaintedItem
+{
+  public:
+    explicit PainterRoundAnimatedImage(QQuickItem* parent = nullptr)
+        : QQuickPaintedItem(parent),
+          m_movie(MEDIA_PATH)
+    {
+        setAntialiasing(true);
+    }
+
+    void nextFrame()
+    {
+        if (!m_movie.jumpToNextFrame()) {
+            m_movie.jumpToFrame(0);
+        }
+        update();
+    }
+
+    void paint(QPainter* painter) override
+    {
+        QRectF bounds = boundingRect();
+        painter->setRenderHint(QPainter::Antialiasing, true);
+
+        QPainterPath path;
+        path.addEllipse(bounds);
+        painter->setClipPath(path);
+
+        QImage frame = m_movie.currentImage();
+        if (frame.isNull()) {
+            painter->fillRect(bounds, Qt::black);
+            return;
+        }
+
+        // Computed but never used, exactly like the original
+        QImage scaledFrame = frame.scaled(bounds.size().toSize(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+        Q_UNUSED(scaledFrame)
+
+        painter->drawImage(bounds, frame);
+    }
+
+  private:
+    QMovie m_movie;
+};
+
+/**
+ * CPU time per animation frame, rendered with the software scene graph on an offscreen window.
+ * On the device the texture drawing of the scene graph path happens on the GPU, so its numbers
+ * here are an upper bound.
+ */
+class TestRoundAnimatedImage : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+
+    void painterPath();
+    void sceneGraphPath();
+};
+
+void TestRoundAnimatedImage::initTestCase()
+{
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    QVERIFY(QFile::exists(MEDIA_PATH));
+}
+
+void TestRoundAnimatedImage::painterPath()
+{
+    QQuickWindow window;
+    window.resize(IMAGE_SIZE, IMAGE_SIZE);
+    PainterRoundAnimatedImage image(window.contentItem());
+    image.setSize(QSizeF(IMAGE_SIZE, IMAGE_SIZE));
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QBENCHMARK {
+        image.nextFrame();
+        window.grabWindow();
+    }
+}
+
+void TestRoundAnimatedImage::sceneGraphPath()
+{
+    QQuickWindow window;
+    window.resize(IMAGE_SIZE, IMAGE_SIZE);
+    RoundAnimatedImage image(window.contentItem());
+    image.setSize(QSizeF(IMAGE_SIZE, IMAGE_SIZE));
+    image.setSource(MEDIA_PATH);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    // Decodes the frames; every frame is uploaded the first time it is shown
+    window.grabWindow();
+
+    QBENCHMARK {
+        QMetaObject::invokeMethod(&image, "onFrameTimeout");
+        window.grabWindow();
+    }
+}
+
+QTEST_MAIN(TestRoundAnimatedImage)
+#include "tst_roundanimatedimage.moc"
@@ -0,0 +1,153 @@
+#include "applications/common/Application.h"
+#include "applications/common/Configuration.h"
+#include "applications/watchface/Application.h"
+#include "services/datetime/Service.h"
+#include <QCoreApplication>
+#include <QTest>
+
+constexpr int MEASUREMENT_MS = 3000;
+
+/**
+ * Watchface on the shared second tick while it is active, the way the time elapsed and
+ * countdown applications are.
+ */
+class TickingApplication : public Common::Application
+{
+  public:
+    TickingApplication(const QString& id, Services::DateTime::Service& dateTime)
+        : Common::Application(id, Common::Type::TimeElapsed, id, 0, Common::Watchface::RoundProgressBar),
+          m_configuration(new Common::Configuration(id, this)),
+          m_dateTime(dateTime)
+    {
+    }
+
+    void applyConfiguration(const QJsonObject& config) override
+    {
+        m_configuration->fromJson(config);
+    }
+
+    Common::Configuration* configuration() const override
+    {
+        return m_configuration;
+    }
+
+    int ticks = 0;
+
+  protected:
+    void onLifecycleChanged(Common::Lifecycle, Common::Lifecycle current) override
+    {
+        if (current == Common::Lifecycle::Active) {
+            connect(&m_dateTime, &Services::DateTime::Service::tick, this, &TickingApplication::onTick, Qt::UniqueConnection);
+        }
+        else {
+            disconnect(&m_dateTime, &Services::DateTime::Service::tick, this, &TickingApplication::onTick);
+        }
+    }
+
+  private:
+    void onTick()
+    {
+        ++ticks;
+    }
+
+    Common::Configuration* m_configuration;
+    Services::DateTime::Service& m_dateTime;
+};
+
+/**
+ * Counts the timer events delivered on the GUI thread, each of which woke the process up.
+ */
+class WakeupCounter : public QObject
+{
+  public:
+    WakeupCounter()
+    {
+        QCoreApplication::instance()->installEventFilter(this);
+    }
+
+    bool eventFilter(QObject* watched, QEvent* event) override
+    {
+        if (event->type() == QEvent::Timer) {
+            ++wakeups;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+    int wakeups = 0;
+};
+
+/**
+ * Timer wakeups per second of a watchface on screen, covered by a menu and hidden.
+ */
+class TestWatchfaceLifecycle : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void followsVisibility();
+
+    void wakeupsPerSecond_data();
+    void wakeupsPerSecond();
+};
+
+void TestWatchfaceLifecycle::followsVisibility()
+{
+    Services::DateTime::Service dateTime;
+    TickingApplication app("a", dateTime);
+    Common::DynamicApplicationMap applications{{"a", &app}};
+    Applications::Watchface::Application watchface(applications);
+    QCOMPARE(app.lifecycle(), Common::Lifecycle::Suspended);
+
+    watchface.setShown(true);
+    QCOMPARE(app.lifecycle(), Common::Lifecycle::Active);
+    QTRY_VERIFY(dateTime.ticking());
+    QTRY_VERIFY(app.ticks > 0);
+
+    watchface.setCovered(true);
+    QCOMPARE(app.lifecycle(), Common::Lifecycle::Background);
+    QTRY_VERIFY(!dateTime.ticking());
+
+    watchface.setCovered(false);
+    watchface.setShown(false);
+    QCOMPARE(app.lifecycle(), Common::Lifecycle::Suspended);
+    QTRY_VERIFY(!dateTime.ticking());
+}
+
+void TestWatchfaceLifecycle::wakeupsPerSecond_data()
+{
+    QTest::addColumn<bool>("shown");
+    QTest::addColumn<bool>("covered");
+
+    QTest::newRow("on screen") << true << false;
+    QTest::newRow("covered by a menu") << true << true;
+    QTest::newRow("hidden") << false << false;
+}
+
+void TestWatchfaceLifecycle::wakeupsPerSecond()
+{
+    QFETCH(bool, shown);
+    QFETCH(bool, covered);
+
+    Services::DateTime::Service dateTime;
+    TickingApplication app("a", dateTime);
+    Common::DynamicApplicationMap applications{{"a", &app}};
+    Applications::Watchface::Application watchface(applications);
+    watchface.setShown(shown);
+    watchface.setCovered(covered);
+    QTest::qWait(100); // Lets the tick start or stop
+
+    WakeupCounter counter;
+    QTest::qWait(MEASUREMENT_MS);
+    const qreal perSecond = counter.wakeups * 1000.0 / MEASUREMENT_MS;
+
+    if (shown && !covered) {
+        QVERIFY(counter.wakeups >= MEASUREMENT_MS / 1000 - 1);
+    }
+    else {
+        QCOMPARE(counter.wakeups, 0);
+    }
+    QTest::setBenchmarkResult(perSecond, QTest::Events);
+}
+
+QTEST_GUILESS_MAIN(TestWatchfaceLifecycle)
+#include "tst_watchfacelifecycle.moc"
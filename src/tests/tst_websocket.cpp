@@ -0,0 +1,368 @@
+#include "drivers/network/Driver.h"
+#include "services/websocket/Service.h"
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QScopeGuard>
+#include <QSet>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QTest>
+#include <QWebSocketServer>
+#include <algorithm>
+
+using namespace Services::WebSocket;
+
+/**
+ * JSON-RPC stand-in for the backend on the loopback interface. Records what the clients send,
+ * answers requests unless told not to, and can restart, dropping every connection at once.
+ */
+class Backend : public QObject
+{
+  public:
+    Backend()
+        : m_server(QStringLiteral("backend"), QWebSocketServer::NonSecureMode)
+    {
+        connect(&m_server, &QWebSocketServer::newConnection, this, &Backend::onNewConnection);
+        m_server.listen(QHostAddress::LocalHost);
+        m_port = m_server.serverPort();
+        m_clock.start();
+    }
+
+    QString url() const
+    {
+        return QStringLiteral("ws://127.0.0.1:%1/ws").arg(m_port);
+    }
+
+    /**
+     * Drops every connection and listens again on the same port.
+     */
+    void restart()
+    {
+        const QList<QWebSocket*> sockets = m_sockets;
+        for (QWebSocket* socket : sockets) {
+            socket->abort();
+        }
+        m_server.close();
+        m_server.listen(QHostAddress::LocalHost, m_port);
+        connectedAt.clear();
+        m_clock.restart();
+    }
+
+    /**
+     * Answers the requests that were held back while answerRequests was off, oldest first.
+     */
+    void answerHeldRequests()
+    {
+        const QList<QPair<QWebSocket*, QJsonObject>> held = m_held;
+        m_held.clear();
+        for (const auto& [socket, request] : held) {
+            if (m_sockets.contains(socket)) {
+                answer(socket, request);
+            }
+        }
+    }
+
+    QList<qint64> connectedAt; // Milliseconds since the backend (re)started
+    QList<QJsonObject> requests;
+    QList<QJsonObject> publishes;
+    bool answerRequests = true; // Otherwise requests are held back without a word
+
+  private:
+    void onNewConnection()
+    {
+        while (QWebSocket* socket = m_server.nextPendingConnection()) {
+            m_sockets.append(socket);
+            connectedAt.append(m_clock.elapsed());
+            connect(socket, &QWebSocket::disconnected, this, [this, socket]() {
+                m_sockets.removeAll(socket);
+                socket->deleteLater();
+            });
+            connect(socket, &QWebSocket::textMessageReceived, this, [this, socket](const QString& message) {
+                onMessage(socket, QJsonDocument::fromJson(message.toUtf8()).object());
+            });
+        }
+    }
+
+    void onMessage(QWebSocket* socket, const QJsonObject& message)
+    {
+        if (message["type"].toString() == "publish") {
+            publishes.append(message);
+            return;
+        }
+
+        requests.append(message);
+        if (answerRequests) {
+            answer(socket, message);
+        }
+        else {
+            m_held.append({socket, message});
+        }
+    }
+
+    void answer(QWebSocket* socket, const QJsonObject& request)
+    {
+        const QJsonObject response{{"jsonrpc", "2.0"}, {"type", "response"}, {"id", request["id"]}, {"result", QJsonObject()}};
+        socket->sendTextMessage(QString::fromUtf8(QJsonDocument(response).toJson(QJsonDocument::Compact)));
+    }
+
+    QWebSocketServer m_server;
+    QList<QWebSocket*> m_sockets;
+    QList<QPair<QWebSocket*, QJsonObject>> m_held;
+    quint16 m_port = 0;
+    QElapsedTimer m_clock;
+};
+
+namespace
+{
+struct Outcome
+{
+    bool done = false;
+    bool success = false;
+    QString error;
+};
+
+Service::ResponseCallback recordInto(Outcome& outcome)
+{
+    return [&outcome](bool success, const QJsonObject&, const QString& error) {
+        outcome.done = true;
+        outcome.success = success;
+        outcome.error = error;
+    };
+}
+
+void setMaxRequestsInFlight(int max)
+{
+    QSettings settings;
+    settings.setValue("websocket-api/max-requests-in-flight", max);
+}
+} // namespace
+
+class TestWebSocket : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void spreadsReconnectsOfAFleet();
+    void timesOutUnansweredRequest();
+    void capsRequestsInFlightAndDrainsInOrder();
+    void expiresQueuedRequests();
+    void failsRequestsWhenQueueIsFull();
+    void failsAllRequestsOnDisconnect();
+
+  private:
+    Drivers::Network::Driver* m_network = nullptr;
+    Backend* m_backend = nullptr;
+};
+
+void TestWebSocket::initTestCase()
+{
+    // Keeps the server url and limits out of the settings of the application
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void TestWebSocket::init()
+{
+    QSettings().remove("websocket-api");
+
+    m_network = new Drivers::Network::Driver();
+    if (!m_network->loopbackInterfaceConnected()) {
+        QSKIP("The loopback interface is not up");
+    }
+    m_backend = new Backend();
+}
+
+void TestWebSocket::cleanup()
+{
+    delete m_backend;
+    delete m_network;
+    m_backend = nullptr;
+    m_network = nullptr;
+}
+
+void TestWebSocket::spreadsReconnectsOfAFleet()
+{
+    constexpr int FLEET_SIZE = 10;
+    QList<Service*> fleet;
+    for (int i = 0; i < FLEET_SIZE; ++i) {
+        fleet.append(new Service(*m_network));
+        fleet.last()->setServerUrl(m_backend->url());
+    }
+    auto deleteFleet = qScopeGuard([&fleet]() {
+        qDeleteAll(fleet);
+    });
+    auto allConnected = [&fleet](bool connected) {
+        return std::all_of(fleet.cbegin(), fleet.cend(), [connected](const Service* service) {
+            return service->connected() == connected;
+        });
+    };
+    QTRY_VERIFY(allConnected(true));
+
+    m_backend->restart();
+    QTRY_VERIFY(allConnected(false));
+
+    // Published during the outage, delivered once reconnected
+    for (int i = 0; i < FLEET_SIZE; ++i) {
+        fleet.at(i)->publish(Topic::ApplicationStatus, QJsonObject{{"client", i}});
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_backend->connectedAt.size(), FLEET_SIZE, 5000);
+    const auto [first, last] = std::minmax_element(m_backend->connectedAt.cbegin(), m_backend->connectedAt.cend());
+    qInfo() << "Fleet of" << FLEET_SIZE << "reconnected between" << *first << "and" << *last << "ms after the restart";
+
+    // The first delay is jittered between 500 and 1000 ms
+    QVERIFY(*first >= 400);
+    QVERIFY(*last - *first >= 100);
+
+    auto flushed = [this]() {
+        QSet<int> clients;
+        for (const QJsonObject& publish : std::as_const(m_backend->publishes)) {
+            const QJsonObject params = publish["params"].toObject();
+            if (publish["topic"].toString() == "application-status" && params.contains("client")) {
+                clients.insert(params["client"].toInt());
+            }
+        }
+        return clients.size();
+    };
+    QTRY_COMPARE(flushed(), FLEET_SIZE);
+}
+
+void TestWebSocket::timesOutUnansweredRequest()
+{
+    m_backend->answerRequests = false;
+    Outcome outcome;
+    Service service(*m_network);
+    service.setServerUrl(m_backend->url());
+    QTRY_VERIFY(service.connected());
+
+    service.request(Method::GetConfig, QJsonObject(), recordInto(outcome), 200);
+    QTRY_COMPARE(m_backend->requests.size(), 1);
+    QCOMPARE(service.requestsInFlight(), 1);
+
+    QTRY_VERIFY(outcome.done);
+    QVERIFY(!outcome.success);
+    QCOMPARE(outcome.error, QStringLiteral("Request timed out"));
+    QCOMPARE(service.requestsInFlight(), 0);
+    QCOMPARE(service.requestLatencies()["getConfig"].toMap()["timeouts"].toULongLong(), quint64(1));
+}
+
+void TestWebSocket::capsRequestsInFlightAndDrainsInOrder()
+{
+    setMaxRequestsInFlight(2);
+    m_backend->answerRequests = false;
+    QList<Outcome> outcomes(5);
+    Service service(*m_network);
+    service.setServerUrl(m_backend->url());
+    QTRY_VERIFY(service.connected());
+
+    for (int i = 0; i < outcomes.size(); ++i) {
+        service.request(Method::GetMedia, QJsonObject{{"n", i}}, recordInto(outcomes[i]));
+    }
+    QTRY_COMPARE(m_backend->requests.size(), 2);
+    QCOMPARE(service.requestsInFlight(), 2);
+    QCOMPARE(service.requestsQueued(), 3);
+
+    // Every answer frees a slot for the oldest queued request
+    while (m_backend->requests.size() < outcomes.size()) {
+        const qsizetype sent = m_backend->requests.size();
+        m_backend->answerHeldRequests();
+        QTRY_VERIFY(m_backend->requests.size() > sent);
+        QVERIFY(service.requestsInFlight() <= 2);
+    }
+    m_backend->answerHeldRequests();
+
+    for (const Outcome& outcome : std::as_const(outcomes)) {
+        QTRY_VERIFY(outcome.done);
+        QVERIFY(outcome.success);
+    }
+    for (int i = 0; i < m_backend->requests.size(); ++i) {
+        QCOMPARE(m_backend->requests.at(i)["params"].toObject()["n"].toInt(), i);
+    }
+    QCOMPARE(service.requestsQueued(), 0);
+}
+
+void TestWebSocket::expiresQueuedRequests()
+{
+    setMaxRequestsInFlight(1);
+    m_backend->answerRequests = false;
+    Outcome inFlight;
+    Outcome queued;
+    Service service(*m_network);
+    service.setServerUrl(m_backend->url());
+    QTRY_VERIFY(service.connected());
+
+    service.request(Method::GetConfig, QJsonObject(), recordInto(inFlight), 10000);
+    service.request(Method::GetMedia, QJsonObject(), recordInto(queued), 200);
+    QCOMPARE(service.requestsQueued(), 1);
+
+    // The deadline runs from the request() call, not from when the request gets its turn
+    QTRY_VERIFY(queued.done);
+    QVERIFY(!queued.success);
+    QCOMPARE(queued.error, QStringLiteral("Request timed out"));
+    QVERIFY(!inFlight.done);
+    QCOMPARE(service.requestsQueued(), 0);
+    QCOMPARE(service.requestLatencies()["getMedia"].toMap()["timeouts"].toULongLong(), quint64(1));
+
+    // Never sent, a late turn would only load the backend with an answer nobody waits for
+    m_backend->answerHeldRequests();
+    QTRY_VERIFY(inFlight.done);
+    QCOMPARE(m_backend->requests.size(), 1);
+}
+
+void TestWebSocket::failsRequestsWhenQueueIsFull()
+{
+    setMaxRequestsInFlight(1);
+    m_backend->answerRequests = false;
+    Outcome rejected;
+    Service service(*m_network);
+    service.setServerUrl(m_backend->url());
+    QTRY_VERIFY(service.connected());
+
+    service.request(Method::GetConfig, QJsonObject(), nullptr);
+    int queued = 0;
+    while (service.requestsQueued() == queued) {
+        service.request(Method::GetConfig, QJsonObject(), nullptr);
+        ++queued;
+    }
+    QCOMPARE(service.requestsQueued(), queued - 1);
+    QVERIFY(queued > 1);
+
+    service.request(Method::GetConfig, QJsonObject(), recordInto(rejected));
+    QVERIFY(rejected.done);
+    QVERIFY(!rejected.success);
+    QCOMPARE(rejected.error, QStringLiteral("Request queue full"));
+    QCOMPARE(service.requestsQueued(), queued - 1);
+}
+
+void TestWebSocket::failsAllRequestsOnDisconnect()
+{
+    setMaxRequestsInFlight(1);
+    m_backend->answerRequests = false;
+    QList<Outcome> outcomes(3);
+    Service service(*m_network);
+    service.setServerUrl(m_backend->url());
+    QTRY_VERIFY(service.connected());
+
+    for (Outcome& outcome : outcomes) {
+        service.request(Method::GetConfig, QJsonObject(), recordInto(outcome));
+    }
+    QCOMPARE(service.requestsInFlight(), 1);
+    QCOMPARE(service.requestsQueued(), 2);
+
+    m_backend->restart();
+    QTRY_VERIFY(!service.connected());
+
+    for (const Outcome& outcome : std::as_const(outcomes)) {
+        QVERIFY(outcome.done);
+        QVERIFY(!outcome.success);
+        QCOMPARE(outcome.error, QStringLiteral("WebSocket disconnected"));
+    }
+    QCOMPARE(service.requestsInFlight(), 0);
+    QCOMPARE(service.requestsQueued(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestWebSocket)
+#include "tst_websocket.moc"
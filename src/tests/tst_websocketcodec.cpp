@@ -0,0 +1,167 @@
+#include "services/websocket/Codec.h"
+#include <QJsonArray>
+#include <QTest>
+
+using namespace Services::WebSocket;
+
+namespace
+{
+QJsonObject publish(const QString& topic, const QJsonObject& params)
+{
+    return QJsonObject{{"jsonrpc", "2.0"}, {"type", "publish"}, {"topic", topic}, {"params", params}};
+}
+
+/**
+ * A configuration publish of a device with many configured applications.
+ */
+QJsonObject configurationPublish()
+{
+    QJsonArray applications;
+    for (int i = 0; i < 200; ++i) {
+        applications.append(QJsonObject{
+            {"id", QStringLiteral("application-%1").arg(i)},
+            {"type", i % 2 ? "time-elapsed" : "countdown"},
+            {"name", QStringLiteral("Application %1").arg(i)},
+            {"enabled", i % 3 != 0},
+            {"priority", i % 10},
+            {"durationSeconds", 30 + i},
+            {"startDate", "2026-01-01T00:00:00Z"},
+            {"media", QJsonArray{QStringLiteral("%1.gif").arg(i), QStringLiteral("%1-background.png").arg(i)}},
+            {"colors", QJsonObject{{"primary", "#ff8800"}, {"secondary", "#002244"}, {"opacity", 0.75}}},
+        });
+    }
+    return publish("configuration", QJsonObject{{"version", 42}, {"timezone", "Europe/Amsterdam"}, {"applications", applications}});
+}
+
+/**
+ * A media publish with the manifest of a large library.
+ */
+QJsonObject mediaPublish()
+{
+    QJsonArray files;
+    for (int i = 0; i < 2000; ++i) {
+        files.append(QJsonObject{
+            {"name", QStringLiteral("%1.gif").arg(i)},
+            {"size", 250000 + i},
+            {"sha256", "3a6eb0790f39ac87c94f3856b2dd2c5d110e6811602261a9a923d3bb23adc8b7"},
+            {"etag", QStringLiteral("\"%1\"").arg(i)},
+        });
+    }
+    return publish("media", QJsonObject{{"files", files}});
+}
+} // namespace
+
+/**
+ * Encode and decode cost of large publishes per negotiated encoding. Text frames include the
+ * UTF-8 to UTF-16 conversion the socket does for them, and back.
+ */
+class TestWebSocketCodec : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void roundTrips_data();
+    void roundTrips();
+    void rejectsInvalidFrames();
+
+    void encode_data();
+    void encode();
+    void decode_data();
+    void decode();
+
+  private:
+    void addMessages();
+};
+
+void TestWebSocketCodec::addMessages()
+{
+    QTest::addColumn<Encoding>("encoding");
+    QTest::addColumn<QJsonObject>("message");
+
+    const QJsonObject configuration = configurationPublish();
+    const QJsonObject media = mediaPublish();
+    QTest::newRow("configuration text") << Encoding::Text << configuration;
+    QTest::newRow("configuration json") << Encoding::BinaryJson << configuration;
+    QTest::newRow("configuration cbor") << Encoding::Cbor << configuration;
+    QTest::newRow("media text") << Encoding::Text << media;
+    QTest::newRow("media json") << Encoding::BinaryJson << media;
+    QTest::newRow("media cbor") << Encoding::Cbor << media;
+}
+
+void TestWebSocketCodec::roundTrips_data()
+{
+    addMessages();
+}
+
+void TestWebSocketCodec::roundTrips()
+{
+    QFETCH(Encoding, encoding);
+    QFETCH(QJsonObject, message);
+
+    QJsonObject decoded;
+    QString error;
+    QVERIFY2(Codec::decode(Codec::encode(message, encoding), encoding, decoded, error), qPrintable(error));
+    QCOMPARE(decoded, message);
+}
+
+void TestWebSocketCodec::rejectsInvalidFrames()
+{
+    QJsonObject decoded;
+    QString error;
+    QVERIFY(!Codec::decode("{\"type\":", Encoding::BinaryJson, decoded, error));
+    QVERIFY(!error.isEmpty());
+
+    error.clear();
+    QVERIFY(!Codec::decode("[1,2]", Encoding::Text, decoded, error));
+    QVERIFY(!error.isEmpty());
+
+    error.clear();
+    QVERIFY(!Codec::decode(QByteArray::fromHex("ff00"), Encoding::Cbor, decoded, error));
+    QVERIFY(!error.isEmpty());
+}
+
+void TestWebSocketCodec::encode_data()
+{
+    addMessages();
+}
+
+void TestWebSocketCodec::encode()
+{
+    QFETCH(Encoding, encoding);
+    QFETCH(QJsonObject, message);
+
+    qsizetype size = 0;
+    QBENCHMARK {
+        const QByteArray frame = Codec::encode(message, encoding);
+        size = encoding == Encoding::Text ? QString::fromUtf8(frame).size() : frame.size();
+    }
+    QVERIFY(size > 0);
+}
+
+void TestWebSocketCodec::decode_data()
+{
+    addMessages();
+}
+
+void TestWebSocketCodec::decode()
+{
+    QFETCH(Encoding, encoding);
+    QFETCH(QJsonObject, message);
+
+    const QByteArray frame = Codec::encode(message, encoding);
+    const QString text = QString::fromUtf8(frame);
+    QJsonObject decoded;
+    QString error;
+    QBENCHMARK {
+        if (encoding == Encoding::Text) {
+            Codec::decode(text.toUtf8(), encoding, decoded, error);
+        }
+        else {
+            Codec::decode(frame, encoding, decoded, error);
+        }
+    }
+    QCOMPARE(decoded, message);
+}
+
+QTEST_GUILESS_MAIN(TestWebSocketCodec)
+#include "tst_websocketcodec.moc"
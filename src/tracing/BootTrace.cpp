@@ -0,0 +1,232 @@
+#include "BootTrace.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+#include <unistd.h>
+
+Q_LOGGING_CATEGORY(lcBootTrace, "bee.boottrace", QtInfoMsg)
+
+using namespace Tracing;
+
+#ifdef PLATFORM_IS_TARGET
+const QString BOOT_TRACE_PATH = QStringLiteral("/usr/share/bee/boot-trace.json");
+#else
+const QString BOOT_TRACE_PATH = QStringLiteral("/workdir/build/bee/boot-trace.json");
+#endif
+
+namespace
+{
+struct Event
+{
+    QByteArray name;
+    const char* category;
+    char phase; // 'X' complete, 'i' instant, 'C' counter
+    qint64 start; // us
+    qint64 value; // duration in us, or counter value
+    quintptr thread;
+};
+
+struct AsyncSpan
+{
+    const char* category;
+    qint64 start;
+};
+
+struct Trace
+{
+    QMutex mutex;
+    QElapsedTimer clock;
+    QList<Event> events;
+    QHash<QByteArray, AsyncSpan> openSpans;
+    bool saveWhenIdle = false;
+    bool saved = false; // Written once, flash is not rewritten for every later marker
+};
+
+Trace& trace()
+{
+    static Trace instance;
+    return instance;
+}
+
+// Caller holds the mutex
+qint64 now(Trace& t)
+{
+    if (!t.clock.isValid()) {
+        t.clock.start();
+    }
+    return t.clock.nsecsElapsed() / 1000;
+}
+
+quintptr currentThread()
+{
+    return reinterpret_cast<quintptr>(QThread::currentThreadId());
+}
+
+// Resident set size in kB, from the second field of /proc/self/statm (in pages)
+qint64 residentMemoryKb()
+{
+    QFile file(QStringLiteral("/proc/self/statm"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+
+    const QList<QByteArray> fields = file.readAll().split(' ');
+    if (fields.size() < 2) {
+        return -1;
+    }
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE) / 1024;
+}
+} // namespace
+
+BootTrace::Span::Span(const char* name, const char* category)
+    : m_name(name),
+      m_category(category)
+{
+    Trace& t = trace();
+    QMutexLocker locker(&t.mutex);
+    m_start = now(t);
+}
+
+BootTrace::Span::~Span()
+{
+    Trace& t = trace();
+    QMutexLocker locker(&t.mutex);
+    const qint64 duration = now(t) - m_start;
+    t.events.append(Event{QByteArray(m_name), m_category, 'X', m_start, duration, currentThread()});
+    locker.unlock();
+
+    qCDebug(lcBootTrace) << m_name << "took" << duration / 1000.0 << "ms";
+}
+
+void BootTrace::start()
+{
+    Trace& t = trace();
+    QMutexLocker locker(&t.mutex);
+    now(t);
+}
+
+void BootTrace::beginAsync(const char* name, const char* category)
+{
+    Trace& t = trace();
+    QMutexLocker locker(&t.mutex);
+    t.openSpans.insert(QByteArray(name), AsyncSpan{category, now(t)});
+}
+
+void BootTrace::endAsync(const char* name)
+{
+    Trace& t = trace();
+    QMutexLocker locker(&t.mutex);
+    auto it = t.openSpans.find(QByteArray(name));
+    if (it == t.openSpans.end()) {
+        return;
+    }
+
+    const qint64 duration = now(t) - it->start;
+    t.events.append(Event{QByteArray(name), it->category, 'X', it->start, duration, currentThread()});
+    t.openSpans.erase(it);
+    const bool saveNow = t.saveWhenIdle && !t.saved && t.openSpans.isEmpty();
+    t.saved = t.saved || saveNow;
+    locker.unlock();
+
+    qCDebug(lcBootTrace) << name << "took" << duration / 1000.0 << "ms";
+    if (saveNow) {
+        save(BOOT_TRACE_PATH);
+    }
+}
+
+void BootTrace::instant(const QString& name, const char* category)
+{
+    const qint64 memory = residentMemoryKb();
+
+    Trace& t = trace();
+    QMutexLocker locker(&t.mutex);
+    const qint64 timestamp = now(t);
+    t.events.append(Event{name.toUtf8(), category, 'i', timestamp, 0, currentThread()});
+    if (memory >= 0) {
+        t.events.append(Event{QByteArrayLiteral("Resident memory (kB)"), category, 'C', timestamp, memory, currentThread()});
+    }
+    locker.unlock();
+
+    qCInfo(lcBootTrace) << name << "after" << timestamp / 1000.0 << "ms, resident memory" << memory << "kB";
+}
+
+void BootTrace::saveWhenIdle()
+{
+    Trace& t = trace();
+    QMutexLocker locker(&t.mutex);
+    t.saveWhenIdle = true;
+    const bool saveNow = !t.saved && t.openSpans.isEmpty();
+    t.saved = t.saved || saveNow;
+    locker.unlock();
+
+    if (saveNow) {
+        save(BOOT_TRACE_PATH);
+    }
+}
+
+QByteArray BootTrace::toJson()
+{
+    Trace& t = trace();
+    QMutexLocker locker(&t.mutex);
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray events;
+    for (const Event& event : std::as_const(t.events)) {
+        QJsonObject object;
+        object["name"] = QString::fromUtf8(event.name);
+        object["cat"] = QString::fromUtf8(event.category);
+        object["ph"] = QString(QChar::fromLatin1(event.phase));
+        object["ts"] = event.start;
+        object["pid"] = pid;
+        object["tid"] = static_cast<qint64>(event.thread);
+        if (event.phase == 'X') {
+            object["dur"] = event.value;
+        }
+        else if (event.phase == 'C') {
+            object["args"] = QJsonObject{{"value", event.value}};
+        }
+        else {
+            object["s"] = QStringLiteral("g"); // Instant events span all threads
+        }
+        events.append(object);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = QStringLiteral("ms");
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool BootTrace::save(const QString& filePath)
+{
+    const QByteArray json = toJson();
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(lcBootTrace) << "Failed to save boot trace to" << filePath;
+        return false;
+    }
+
+    file.write(json);
+    if (!file.commit()) {
+        qCWarning(lcBootTrace) << "Failed to save boot trace to" << filePath << ":" << file.errorString();
+        return false;
+    }
+
+    Trace& t = trace();
+    QMutexLocker locker(&t.mutex);
+    qCInfo(lcBootTrace) << "Boot trace with" << t.events.size() << "events saved to" << filePath;
+    return true;
+}
@@ -0,0 +1,73 @@
+#ifndef TRACING_BOOTTRACE_H
+#define TRACING_BOOTTRACE_H
+
+#include <QByteArray>
+#include <QLoggingCategory>
+#include <QString>
+
+Q_DECLARE_LOGGING_CATEGORY(lcBootTrace)
+
+namespace Tracing
+{
+/**
+ * Records named spans during boot and exports them as Chrome trace-event JSON
+ * (open in chrome://tracing or ui.perfetto.dev). Thread-safe, timestamps are relative
+ * to the start of the process (the first call to start()). Span names and categories are
+ * kept by pointer, so they must be string literals.
+ */
+class BootTrace
+{
+  public:
+    /**
+     * Scoped span, recorded as a complete event when it goes out of scope.
+     */
+    class Span
+    {
+      public:
+        explicit Span(const char* name, const char* category = "boot");
+        ~Span();
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+      private:
+        const char* m_name;
+        const char* m_category;
+        qint64 m_start;
+    };
+
+    static void start();
+
+    /**
+     * Spans that end in another call stack, e.g. startup checks that complete on a reply.
+     */
+    static void beginAsync(const char* name, const char* category = "boot");
+    static void endAsync(const char* name);
+
+    /**
+     * Marker, recorded together with the resident memory at that moment.
+     */
+    static void instant(const QString& name, const char* category = "boot");
+
+    /**
+     * Write the trace once no asynchronous span is open any more (immediately when none is).
+     * The file is only written once, later events are left out of it.
+     */
+    static void saveWhenIdle();
+
+    static QByteArray toJson();
+    static bool save(const QString& filePath);
+};
+
+/**
+ * Construct an object inside a span, so members can be traced from a constructor's initializer list.
+ */
+template <typename Factory>
+auto traced(const char* name, Factory factory)
+{
+    BootTrace::Span span(name);
+    return factory();
+}
+} // namespace Tracing
+
+#endif // TRACING_BOOTTRACE_H